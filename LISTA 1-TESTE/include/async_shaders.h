@@ -0,0 +1,241 @@
+#ifndef ASYNC_SHADERS_H
+#define ASYNC_SHADERS_H
+
+// Compilação de shaders fora da thread de renderização.
+//
+// glCompileShader/glLinkProgram seguidos de glGetShaderiv/glGetProgramiv
+// bloqueiam a thread até o driver terminar. Aqui uma janela GLFW invisível,
+// com contexto compartilhado com o da janela principal, fica corrente numa
+// thread de trabalho que compila e liga os programas pedidos. Ao terminar
+// cada um, a thread cria uma fence; a thread principal consulta a fence sem
+// esperar e só passa a usar o programa quando ela já foi sinalizada.
+// Enquanto isso, asyncProgram devolve um programa reserva (posição na
+// location 0, cor cinza), então o primeiro quadro sai sem esperar o driver.
+//
+// Uso (depois da GLAD):
+//   AsyncShaderCompiler compiler = createAsyncShaderCompiler(window);
+//   int program = compileProgramAsync(compiler, vertexSource, fragmentSource);
+//   while (nextFrame(window)) {
+//       glstate::useProgram(asyncProgram(compiler, program));
+//       ...
+//   }
+//   deleteAsyncShaderCompiler(compiler);  //antes de destruir a janela principal
+//
+// Os programas passam pelo cache de shaders (shader_cache.h) da thread que
+// compila: pedidos com o mesmo código dão o mesmo programa, e com
+// enableProgramBinaryCache ligado (na thread principal, antes de pedir) o
+// programa sai do binário em disco sem compilar. O cache da thread de
+// trabalho é apagado quando ela termina, em deleteAsyncShaderCompiler.
+// Uniforms devem ser consultadas quando asyncProgramReady indicar que o
+// programa definitivo já está em uso.
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gl_state.h>
+#include <render_loop.h>
+#include <shader_cache.h>
+#include <shader_preprocessor.h>
+
+namespace asyncshaders::detail {
+
+struct AsyncCompileJob {
+    int handle = -1;
+    std::string vertexSource, fragmentSource;
+    shadercache::detail::ProgramBinaryStore binaries;  // cache em disco da thread principal
+};
+
+struct AsyncCompileResult {
+    int handle = -1;
+    GLuint program = 0;
+    bool linked = false;
+    GLsync fence = 0;
+};
+
+struct AsyncCompileWorker {
+    GLFWwindow* context = nullptr;  // janela invisível, contexto compartilhado
+    std::thread thread;
+
+    std::mutex mutex;  // protege jobs, results e stop
+    std::condition_variable wake;
+    std::deque<AsyncCompileJob> jobs;
+    std::vector<AsyncCompileResult> results;
+    bool stop = false;
+};
+
+struct AsyncProgram {
+    GLuint program = 0;  // definitivo, depois de ligado na thread de trabalho
+    GLsync fence = 0;    // sinalizada quando o programa está pronto para este contexto
+    bool ready = false;
+    bool failed = false;
+};
+
+inline void runAsyncCompileWorker(AsyncCompileWorker* worker) {
+    glfwMakeContextCurrent(worker->context);
+    for (;;) {
+        AsyncCompileJob job;
+        {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+            worker->wake.wait(lock, [worker] { return worker->stop || !worker->jobs.empty(); });
+            if (worker->stop) break;
+            job = std::move(worker->jobs.front());
+            worker->jobs.pop_front();
+        }
+
+        AsyncCompileResult result;
+        result.handle = job.handle;
+        //O cache desta thread usa o mesmo diretório de binários da principal
+        shadercache::detail::shaderCache().binaries = job.binaries;
+        result.program = getCachedProgram(job.vertexSource.c_str(), job.fragmentSource.c_str());
+        GLint success = 0;
+        glGetProgramiv(result.program, GL_LINK_STATUS, &success);
+        result.linked = success != 0;
+        result.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();  //a fence precisa chegar ao driver para ser vista pelo outro contexto
+
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->results.push_back(result);
+        }
+        postRedraw();
+    }
+    clearShaderCache();  //programas compilados aqui, inclusive os que não chegaram a ser entregues
+    glfwMakeContextCurrent(nullptr);
+}
+
+} // namespace asyncshaders::detail
+
+struct AsyncShaderCompiler {
+    GLuint fallback = 0;
+    std::vector<asyncshaders::detail::AsyncProgram> programs;
+    std::unique_ptr<asyncshaders::detail::AsyncCompileWorker> worker;  // nulo: compila na thread principal
+};
+
+// Cria a janela invisível com o mesmo tipo de contexto da janela principal
+// e inicia a thread. Chamar na thread principal (exigência da GLFW).
+inline AsyncShaderCompiler createAsyncShaderCompiler(GLFWwindow* mainWindow) {
+    AsyncShaderCompiler compiler;
+    //Reserva: basic.vert/basic.frag da biblioteca, em cinza
+    ShaderDefines gray = {{"SOLID_COLOR", "vec4(0.5, 0.5, 0.5, 1.0)"}};
+    compiler.fallback = getCachedProgram(preprocessShader("basic.vert", gray).c_str(),
+                                         preprocessShader("basic.frag", gray).c_str());
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* context = glfwCreateWindow(1, 1, "", nullptr, mainWindow);
+    glfwDefaultWindowHints();
+    if (!context) {
+        std::cerr << "Contexto compartilhado indisponivel: shaders serao compilados na thread principal" << std::endl;
+        return compiler;
+    }
+
+    compiler.worker = std::make_unique<asyncshaders::detail::AsyncCompileWorker>();
+    compiler.worker->context = context;
+    compiler.worker->thread = std::thread(asyncshaders::detail::runAsyncCompileWorker, compiler.worker.get());
+    return compiler;
+}
+
+inline void deleteAsyncShaderCompiler(AsyncShaderCompiler& compiler) {
+    if (compiler.worker) {
+        {
+            std::lock_guard<std::mutex> lock(compiler.worker->mutex);
+            compiler.worker->stop = true;
+        }
+        compiler.worker->wake.notify_one();
+        compiler.worker->thread.join();  //a thread apaga os programas que compilou
+        for (const asyncshaders::detail::AsyncCompileResult& result : compiler.worker->results)
+            glDeleteSync(result.fence);
+        glfwDestroyWindow(compiler.worker->context);
+    }
+    for (asyncshaders::detail::AsyncProgram& program : compiler.programs) {
+        if (program.fence) glDeleteSync(program.fence);
+        if (compiler.worker)
+            glstate::onDeleteProgram(program.program);
+        else if (program.program)
+            releaseCachedProgram(program.program);  //compilado na thread principal
+    }
+    //O reserva é do cache de shaders
+    compiler = AsyncShaderCompiler();
+}
+
+// Enfileira a compilação e retorna o handle na hora
+inline int compileProgramAsync(AsyncShaderCompiler& compiler, const char* vShaderSrc, const char* fShaderSrc) {
+    int handle = static_cast<int>(compiler.programs.size());
+    compiler.programs.emplace_back();
+    if (!compiler.worker) {
+        asyncshaders::detail::AsyncProgram& program = compiler.programs.back();
+        program.program = getCachedProgram(vShaderSrc, fShaderSrc);
+        GLint success = 0;
+        glGetProgramiv(program.program, GL_LINK_STATUS, &success);
+        program.ready = success != 0;  //com erro, fica no reserva
+        program.failed = !program.ready;
+        return handle;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(compiler.worker->mutex);
+        compiler.worker->jobs.push_back({handle, vShaderSrc, fShaderSrc, shadercache::detail::shaderCache().binaries});
+    }
+    compiler.worker->wake.notify_one();
+    return handle;
+}
+
+namespace asyncshaders::detail {
+
+// Recolhe os resultados da thread de trabalho e testa as fences sem bloquear
+inline void pollAsyncPrograms(AsyncShaderCompiler& compiler) {
+    if (!compiler.worker) return;
+    std::vector<AsyncCompileResult> results;
+    {
+        std::lock_guard<std::mutex> lock(compiler.worker->mutex);
+        results.swap(compiler.worker->results);
+    }
+    for (const AsyncCompileResult& result : results) {
+        AsyncProgram& program = compiler.programs[result.handle];
+        program.program = result.program;
+        program.fence = result.fence;
+        program.failed = !result.linked;
+    }
+
+    for (AsyncProgram& program : compiler.programs) {
+        if (!program.fence) continue;
+        GLenum status = glClientWaitSync(program.fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            scheduleRedraw(0.001);  //no modo sob demanda, volta para conferir
+            continue;
+        }
+        glDeleteSync(program.fence);
+        program.fence = 0;
+        if (program.failed)
+            std::cerr << "Programa assincrono com erro; mantendo o programa reserva" << std::endl;
+        else
+            program.ready = true;
+    }
+}
+
+} // namespace asyncshaders::detail
+
+// Programa definitivo se já estiver pronto; senão o reserva
+inline GLuint asyncProgram(AsyncShaderCompiler& compiler, int handle) {
+    asyncshaders::detail::pollAsyncPrograms(compiler);
+    const asyncshaders::detail::AsyncProgram& program = compiler.programs[handle];
+    return program.ready ? program.program : compiler.fallback;
+}
+
+inline bool asyncProgramReady(AsyncShaderCompiler& compiler, int handle) {
+    asyncshaders::detail::pollAsyncPrograms(compiler);
+    return compiler.programs[handle].ready;
+}
+
+#endif // ASYNC_SHADERS_H
@@ -0,0 +1,265 @@
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+// Renderizador 2D em lote, no estilo "modo imediato".
+//
+// drawPolygon, drawArc, drawStar, drawSpiral e drawPoints não desenham na
+// hora: geram os vértices com os geradores de shapes.h e acrescentam ao lote
+// do quadro. Leques viram triângulos soltos e a espiral vira segmentos
+// soltos, então formas diferentes com cores diferentes (a cor vai em cada
+// vértice) cabem no mesmo lote. O lote só é enviado (flushBatch) quando a
+// primitiva (triângulos, linhas, pontos) ou o programa mudam, e no fim do
+// quadro. Com isso o número de draws por quadro não depende do número de
+// formas.
+//
+// Os vértices passam por um StreamBuffer (stream_buffer.h): cada flush
+// ocupa um trecho da região do quadro, sem esperar a GPU. Se a região encher
+// no meio do quadro, o lote é dividido e continua na próxima região do anel
+// (esperando a fence dela, se preciso); o buffer só cresce no beginBatch
+// seguinte, dimensionado pelo pico do quadro anterior.
+//
+// Uso por quadro:
+//   beginBatch(batch);
+//   setBatchColor(batch, 1.0f, 0.7f, 0.2f);
+//   drawPolygon(batch, 8, 0.3f, -0.6f, 0.5f);
+//   ...
+//   endBatch(batch);
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gl_state.h>
+#include <shader_cache.h>
+#include <shapes.h>
+#include <stream_buffer.h>
+#include <tessellation.h>
+#include <vertex_formats.h>
+#include <vertex_layout.h>
+
+struct BatchVertex {
+    float position[2];
+    std::uint8_t color[4];
+};
+
+inline constexpr auto kBatchVertexLayout = makeVertexLayout<BatchVertex>(
+    VERTEX_ATTRIBUTE(BatchVertex, position, 0, false),
+    VERTEX_ATTRIBUTE(BatchVertex, color, 1, true));
+
+namespace batchrenderer::detail {
+
+const char* const kBatchVertexShader = R"(
+    #version 330 core
+    layout (location = 0) in vec2 aPos;
+    layout (location = 1) in vec4 aColor;
+    out vec4 vertexColor;
+    void main() {
+        gl_Position = vec4(aPos, 0.0, 1.0);
+        vertexColor = aColor;
+    }
+)";
+
+const char* const kBatchFragmentShader = R"(
+    #version 330 core
+    in vec4 vertexColor;
+    out vec4 FragColor;
+    void main() {
+        FragColor = vertexColor;
+    }
+)";
+
+} // namespace batchrenderer::detail
+
+struct BatchRenderer {
+    GLuint defaultProgram = 0;
+    GLuint program = 0;               // programa do lote atual
+    GLuint VAO = 0;
+    StreamBuffer stream;
+    GLenum mode = GL_TRIANGLES;       // primitiva do lote atual
+    std::vector<BatchVertex> vertices; // lote atual, ainda na CPU
+    std::vector<float> scratch;        // saída x, y, z dos geradores
+    std::uint8_t color[4] = { 255, 255, 255, 255 };
+    int drawCalls = 0;                // draws emitidos no quadro atual
+    std::size_t frameBytes = 0;       // bytes pedidos no quadro atual (pico para o próximo beginBatch)
+};
+
+// maxVerticesPerFrame dimensiona o buffer; se um quadro passar disso, o buffer
+// cresce no beginBatch seguinte
+inline BatchRenderer createBatchRenderer(std::size_t maxVerticesPerFrame = 65536) {
+    BatchRenderer batch;
+    batch.defaultProgram = getCachedProgram(batchrenderer::detail::kBatchVertexShader, batchrenderer::detail::kBatchFragmentShader);
+    batch.program = batch.defaultProgram;
+    batch.stream = createStreamBuffer(maxVerticesPerFrame * sizeof(BatchVertex));
+    batch.vertices.reserve(maxVerticesPerFrame);
+
+    glGenVertexArrays(1, &batch.VAO);
+    glstate::bindVertexArray(batch.VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, batch.stream.VBO);
+    setInterleavedLayout(kBatchVertexLayout);
+    glstate::bindVertexArray(0);
+    return batch;
+}
+
+inline void deleteBatchRenderer(BatchRenderer& batch) {
+    //O programa padrão é do cache de shaders
+    glstate::onDeleteVertexArray(batch.VAO);
+    glDeleteVertexArrays(1, &batch.VAO);
+    deleteStreamBuffer(batch.stream);
+    batch = BatchRenderer();
+}
+
+namespace batchrenderer::detail {
+
+// Vértices por primitiva do lote: um corte só pode cair entre primitivas
+inline std::size_t batchPrimitiveSize(GLenum mode) {
+    return mode == GL_TRIANGLES ? 3 : (mode == GL_LINES ? 2 : 1);
+}
+
+} // namespace batchrenderer::detail
+
+// Envia o lote atual num único glDrawArrays (ou em mais de um, se não couber
+// no que resta da região)
+inline void flushBatch(BatchRenderer& batch) {
+    if (batch.vertices.empty()) return;
+    const std::size_t total = batch.vertices.size();
+    const std::size_t primitive = batchrenderer::detail::batchPrimitiveSize(batch.mode);
+    batch.frameBytes += total * sizeof(BatchVertex);
+
+    glstate::useProgram(batch.program);
+    glstate::bindVertexArray(batch.VAO);
+    std::size_t first = 0;
+    bool freshRegion = false;
+    while (first < total) {
+        std::size_t count = std::min(total - first, streamCapacity(batch.stream, sizeof(BatchVertex)));
+        count -= count % primitive;
+        if (count == 0) {
+            //Região cheia: fecha com a fence e segue na próxima do anel
+            if (freshRegion) break; //uma região vazia não comporta nem uma primitiva
+            endStreamFrame(batch.stream);
+            beginStreamFrame(batch.stream);
+            freshRegion = true;
+            continue;
+        }
+        StreamSpan span = streamAllocate(batch.stream, count, sizeof(BatchVertex));
+        if (!span.data) break;
+        std::memcpy(span.data, batch.vertices.data() + first, count * sizeof(BatchVertex));
+        if (streamCommit(batch.stream, span)) {
+            glDrawArrays(batch.mode, span.firstVertex, static_cast<GLsizei>(count));
+            batch.drawCalls++;
+        }
+        first += count;
+        freshRegion = false;
+    }
+    batch.vertices.clear();
+}
+
+// Cresce o buffer entre quadros, se o quadro anterior precisou dividir lotes
+inline void beginBatch(BatchRenderer& batch) {
+    if (batch.frameBytes > batch.stream.regionBytes)
+        reserveStreamBuffer(batch.stream, 2 * batch.frameBytes);
+    beginStreamFrame(batch.stream);
+    batch.drawCalls = 0;
+    batch.frameBytes = 0;
+}
+
+inline void endBatch(BatchRenderer& batch) {
+    flushBatch(batch);
+    endStreamFrame(batch.stream);
+}
+
+// Programa dos próximos desenhos (0 volta ao padrão). Outros programas devem
+// ler aPos (vec2, location 0) e aColor (vec4, location 1).
+inline void setBatchProgram(BatchRenderer& batch, GLuint program) {
+    if (program == 0) program = batch.defaultProgram;
+    if (program == batch.program) return;
+    flushBatch(batch);
+    batch.program = program;
+}
+
+// Cor dos próximos desenhos; não quebra o lote
+inline void setBatchColor(BatchRenderer& batch, float r, float g, float b, float a = 1.0f) {
+    batch.color[0] = toUnorm8(r);
+    batch.color[1] = toUnorm8(g);
+    batch.color[2] = toUnorm8(b);
+    batch.color[3] = toUnorm8(a);
+}
+
+namespace batchrenderer::detail {
+
+inline void setBatchMode(BatchRenderer& batch, GLenum mode) {
+    if (mode == batch.mode) return;
+    flushBatch(batch);
+    batch.mode = mode;
+}
+
+inline void pushBatchVertex(BatchRenderer& batch, const float* xyz) {
+    BatchVertex vertex;
+    vertex.position[0] = xyz[0];
+    vertex.position[1] = xyz[1];
+    std::memcpy(vertex.color, batch.color, sizeof(vertex.color));
+    batch.vertices.push_back(vertex);
+}
+
+// Leque em scratch (centro + contorno) -> triângulos (centro, i, i + 1)
+inline void appendFanTriangles(BatchRenderer& batch, std::size_t fanCount) {
+    setBatchMode(batch, GL_TRIANGLES);
+    const float* fan = batch.scratch.data();
+    for (std::size_t i = 1; i + 1 < fanCount; i++) {
+        pushBatchVertex(batch, fan);
+        pushBatchVertex(batch, fan + 3 * i);
+        pushBatchVertex(batch, fan + 3 * (i + 1));
+    }
+}
+
+} // namespace batchrenderer::detail
+
+inline void drawPolygon(BatchRenderer& batch, int sides, float radius, float cx, float cy, float maxError = 0.0f) {
+    std::size_t count = polygonVertexCount(sides);
+    batch.scratch.resize(3 * count);
+    writePolygonVertices(batch.scratch.data(), sides, radius, cx, cy, maxError);
+    batchrenderer::detail::appendFanTriangles(batch, count);
+}
+
+inline void drawArc(BatchRenderer& batch, float angleStart, float angleEnd, float radius, float cx, float cy,
+                    float maxError = 0.0f) {
+    std::size_t count = arcVertexCount(angleStart, angleEnd, radius);
+    batch.scratch.resize(3 * count);
+    writeArc(batch.scratch.data(), angleStart, angleEnd, radius, cx, cy, maxError);
+    batchrenderer::detail::appendFanTriangles(batch, count);
+}
+
+inline void drawStar(BatchRenderer& batch, int points, float innerR, float outerR, float cx, float cy,
+                     float maxError = 0.0f) {
+    std::size_t count = starVertexCount(points);
+    batch.scratch.resize(3 * count);
+    writeStar(batch.scratch.data(), points, innerR, outerR, cx, cy, maxError);
+    batchrenderer::detail::appendFanTriangles(batch, count);
+}
+
+// Espiral amostrada pela curvatura (flecha <= 1/4 de pixel), como segmentos soltos
+inline void drawSpiral(BatchRenderer& batch, int numTurns, float maxRadius, float cx, float cy) {
+    float tolerance = tessellation::pixelErrorToNdc();
+    std::size_t count = spiralAdaptiveVertexCount(SpiralSampling::Curvature, numTurns, maxRadius, tolerance);
+    batch.scratch.resize(3 * count);
+    writeSpiralAdaptive(batch.scratch.data(), SpiralSampling::Curvature, numTurns, maxRadius, tolerance, cx, cy);
+
+    batchrenderer::detail::setBatchMode(batch, GL_LINES);
+    const float* strip = batch.scratch.data();
+    for (std::size_t i = 0; i + 1 < count; i++) {
+        batchrenderer::detail::pushBatchVertex(batch, strip + 3 * i);
+        batchrenderer::detail::pushBatchVertex(batch, strip + 3 * (i + 1));
+    }
+}
+
+// count pontos x, y, z (z é ignorado); o tamanho vem de glPointSize
+inline void drawPoints(BatchRenderer& batch, const float* points, std::size_t count) {
+    batchrenderer::detail::setBatchMode(batch, GL_POINTS);
+    for (std::size_t i = 0; i < count; i++)
+        batchrenderer::detail::pushBatchVertex(batch, points + 3 * i);
+}
+
+#endif // BATCH_RENDERER_H
@@ -0,0 +1,203 @@
+#ifndef BULK_SHAPES_H
+#define BULK_SHAPES_H
+
+// Geração em massa de formas (polígonos, arcos e estrelas) em paralelo.
+//
+// 1. Conta os vértices de cada forma (em paralelo).
+// 2. Soma de prefixos sobre as contagens: cada forma ganha o seu offset no
+//    buffer de saída, então cada thread escreve numa fatia disjunta sem
+//    nenhuma sincronização.
+// 3. Escreve os vértices (em paralelo), com as fatias divididas pelo número
+//    de vértices, não de formas, para equilibrar círculos grandes e estrelas.
+//
+// O resultado já está no formato de glMultiDrawArrays(GL_TRIANGLE_FAN, ...):
+// first[i] e count[i] são o primeiro vértice e o número de vértices da forma i.
+//
+// As threads são criadas na primeira chamada que precisa delas e ficam
+// esperando as próximas; chamadas seguidas não pagam a criação de threads.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <shapes.h>
+
+enum class ShapeKind { Polygon, Arc, Star };
+
+struct ShapeDesc {
+    ShapeKind kind = ShapeKind::Polygon;
+    int sides = 3;             // lados (Polygon) ou pontas (Star)
+    float radius = 1.0f;       // raio (Polygon, Arc) ou raio externo (Star)
+    float innerRadius = 0.5f;  // raio interno (Star)
+    float angleStart = 0.0f;   // Arc
+    float angleEnd = 0.0f;     // Arc
+    float centerX = 0.0f;
+    float centerY = 0.0f;
+    float maxError = 0.0f;     // ver writeRimVertices
+};
+
+struct BulkShapes {
+    std::vector<float> vertices;  // x, y, z de todas as formas, em sequência
+    std::vector<int> first;       // primeiro vértice de cada forma
+    std::vector<int> count;       // número de vértices de cada forma
+};
+
+inline std::size_t shapeVertexCount(const ShapeDesc& shape) {
+    switch (shape.kind) {
+    case ShapeKind::Arc:  return arcVertexCount(shape.angleStart, shape.angleEnd, shape.radius);
+    case ShapeKind::Star: return starVertexCount(shape.sides);
+    default:              return polygonVertexCount(shape.sides);
+    }
+}
+
+template <typename OutputIt>
+OutputIt writeShape(OutputIt out, const ShapeDesc& shape) {
+    switch (shape.kind) {
+    case ShapeKind::Arc:
+        return writeArc(out, shape.angleStart, shape.angleEnd, shape.radius, shape.centerX, shape.centerY, shape.maxError);
+    case ShapeKind::Star:
+        return writeStar(out, shape.sides, shape.innerRadius, shape.radius, shape.centerX, shape.centerY, shape.maxError);
+    default:
+        return writePolygonVertices(out, shape.sides, shape.radius, shape.centerX, shape.centerY, shape.maxError);
+    }
+}
+
+namespace bulkshapes::detail {
+
+// Threads persistentes: run(n, job) executa job(0) ... job(n - 1) dividido
+// entre elas e a thread que chamou, e só retorna quando todos terminam
+class ShapeWorkerPool {
+public:
+    explicit ShapeWorkerPool(unsigned threadCount) {
+        for (unsigned t = 0; t < threadCount; t++)
+            threads.emplace_back([this] { workerLoop(); });
+    }
+
+    ~ShapeWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    void run(std::size_t count, const std::function<void(std::size_t)>& task) {
+        std::lock_guard<std::mutex> serialize(runMutex);  //uma chamada por vez
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            jobCount = count;
+            nextJob = 0;
+            finished = 0;
+        }
+        wake.notify_all();
+        std::unique_lock<std::mutex> lock(mutex);
+        runJobs(lock);
+        done.wait(lock, [this] { return finished == jobCount; });
+        job = nullptr;
+    }
+
+private:
+    //Pega e executa jobs até acabarem; chamado com mutex travado
+    void runJobs(std::unique_lock<std::mutex>& lock) {
+        while (job && nextJob < jobCount) {
+            std::size_t index = nextJob++;
+            const std::function<void(std::size_t)>& task = *job;
+            lock.unlock();
+            task(index);
+            lock.lock();
+            if (++finished == jobCount) done.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stop || (job && nextJob < jobCount); });
+            if (stop) return;
+            runJobs(lock);
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex runMutex;
+    std::mutex mutex;  // protege os campos abaixo
+    std::condition_variable wake, done;
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t jobCount = 0, nextJob = 0, finished = 0;
+    bool stop = false;
+};
+
+// Um núcleo fica com a thread que chama; as demais são criadas uma vez só
+inline ShapeWorkerPool& shapeWorkerPool() {
+    static ShapeWorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+// Executa task(begin, end) sobre [0, n) dividido em fatias contíguas, uma por thread
+template <typename Task>
+void parallelRanges(std::size_t n, unsigned threadCount, Task task) {
+    if (threadCount <= 1 || n < 2) {
+        task(std::size_t(0), n);
+        return;
+    }
+    std::size_t chunk = (n + threadCount - 1) / threadCount;
+    std::size_t chunks = (n + chunk - 1) / chunk;
+    shapeWorkerPool().run(chunks, [&](std::size_t c) {
+        task(c * chunk, std::min(n, (c + 1) * chunk));
+    });
+}
+
+} // namespace bulkshapes::detail
+
+// Gera as n formas em out. threadCount == 0 usa todos os núcleos. A memória de
+// out é reaproveitada entre chamadas (só cresce).
+inline void generateShapesBulk(const ShapeDesc* shapes, std::size_t n, BulkShapes& out, unsigned threadCount = 0) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    //Para poucas formas, dividir o trabalho custa mais do que gerar
+    const std::size_t minShapesPerThread = 256;
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, std::max<std::size_t>(1, n / minShapesPerThread)));
+
+    out.first.resize(n);
+    out.count.resize(n);
+
+    //1. Contagens
+    bulkshapes::detail::parallelRanges(n, threadCount, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            out.count[i] = static_cast<int>(shapeVertexCount(shapes[i]));
+    });
+
+    //2. Soma de prefixos (exclusiva)
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        out.first[i] = static_cast<int>(total);
+        total += out.count[i];
+    }
+    out.vertices.resize(3 * total);
+
+    //3. Escrita, com fatias de ~total / threadCount vértices cada
+    std::vector<std::size_t> bounds(threadCount + 1, n);
+    bounds[0] = 0;
+    for (unsigned t = 1; t < threadCount; t++) {
+        int target = static_cast<int>(total * t / threadCount);
+        bounds[t] = std::lower_bound(out.first.begin(), out.first.end(), target) - out.first.begin();
+    }
+    bulkshapes::detail::parallelRanges(threadCount, threadCount, [&](std::size_t tBegin, std::size_t tEnd) {
+        for (std::size_t t = tBegin; t < tEnd; t++)
+            for (std::size_t i = bounds[t]; i < bounds[t + 1]; i++)
+                writeShape(&out.vertices[3 * static_cast<std::size_t>(out.first[i])], shapes[i]);
+    });
+}
+
+inline void generateShapesBulk(const std::vector<ShapeDesc>& shapes, BulkShapes& out, unsigned threadCount = 0) {
+    generateShapesBulk(shapes.data(), shapes.size(), out, threadCount);
+}
+
+#endif // BULK_SHAPES_H
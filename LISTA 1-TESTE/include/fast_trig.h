@@ -0,0 +1,369 @@
+#ifndef FAST_TRIG_H
+#define FAST_TRIG_H
+
+// Seno/cosseno em lote (float) para os geradores de formas.
+//
+// Algoritmo: redução de argumento Cody-Waite em 3 partes + polinômios
+// minimax de Cephes (o mesmo esquema do sse_mathfun). Os caminhos escalar,
+// SSE2 e AVX2 executam as mesmas operações na mesma ordem (sem FMA), então
+// produzem os mesmos resultados bit a bit.
+//
+// Precisão, comparando com (float)sin((double)x) / (float)cos((double)x), que é
+// o que os geradores faziam antes:
+//   |x| <= 2*pi  : erro <= 2 ULP
+//   |x| <= 8192  : erro absoluto <= 8e-8 (perto dos zeros o erro relativo cresce)
+// Acima de 8192 a redução de argumento perde precisão rapidamente.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define FAST_TRIG_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(FAST_TRIG_X86) && (defined(__GNUC__) || defined(__clang__))
+#define FAST_TRIG_TARGET(x) __attribute__((target(x)))
+#else
+#define FAST_TRIG_TARGET(x)
+#endif
+
+namespace fasttrig {
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+namespace detail {
+
+constexpr float kFourOverPi = 1.27323954473516f;
+constexpr float kDP1 = -0.78515625f;
+constexpr float kDP2 = -2.4187564849853515625e-4f;
+constexpr float kDP3 = -3.77489497744594108e-8f;
+constexpr float kSinP0 = -1.9515295891e-4f;
+constexpr float kSinP1 = 8.3321608736e-3f;
+constexpr float kSinP2 = -1.6666654611e-1f;
+constexpr float kCosP0 = 2.443315711809948e-5f;
+constexpr float kCosP1 = -1.388731625493765e-3f;
+constexpr float kCosP2 = 4.166664568298827e-2f;
+
+inline void sincosScalar(const float* angles, float* sinOut, float* cosOut, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        float x = angles[i];
+        std::uint32_t signSin;
+        std::memcpy(&signSin, &x, sizeof(float));
+        signSin &= 0x80000000u;
+        x = x < 0.0f ? -x : x;
+
+        // Octante (arredondado para par) e redução de x para [-pi/4, pi/4]
+        std::int32_t j = static_cast<std::int32_t>(x * kFourOverPi);
+        j = (j + 1) & ~1;
+        float y = static_cast<float>(j);
+        x = ((x + y * kDP1) + y * kDP2) + y * kDP3;
+
+        std::uint32_t swapSin = static_cast<std::uint32_t>(j & 4) << 29;
+        std::uint32_t signCos = static_cast<std::uint32_t>(~(j - 2) & 4) << 29;
+        bool usePolySin = (j & 2) == 0;
+
+        float z = x * x;
+        float pc = ((kCosP0 * z + kCosP1) * z + kCosP2) * z * z - 0.5f * z + 1.0f;
+        float ps = ((kSinP0 * z + kSinP1) * z + kSinP2) * z * x + x;
+
+        float s = usePolySin ? ps : pc;
+        float c = usePolySin ? pc : ps;
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &s, sizeof(float));
+        bits ^= signSin ^ swapSin;
+        std::memcpy(&sinOut[i], &bits, sizeof(float));
+        std::memcpy(&bits, &c, sizeof(float));
+        bits ^= signCos;
+        std::memcpy(&cosOut[i], &bits, sizeof(float));
+    }
+}
+
+#ifdef FAST_TRIG_X86
+
+FAST_TRIG_TARGET("sse2")
+inline void sincosSSE2(const float* angles, float* sinOut, float* cosOut, std::size_t count) {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    const __m128i inv1 = _mm_set1_epi32(~1);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128i four = _mm_set1_epi32(4);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(angles + i);
+        __m128 signSin = _mm_and_ps(x, signMask);
+        x = _mm_andnot_ps(signMask, x);
+
+        __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(kFourOverPi)));
+        j = _mm_and_si128(_mm_add_epi32(j, one), inv1);
+        __m128 y = _mm_cvtepi32_ps(j);
+
+        __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, four), 29));
+        __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, two), four), 29));
+        __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, two), _mm_setzero_si128()));
+        signSin = _mm_xor_ps(signSin, swapSin);
+
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP1)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP2)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP3)));
+        __m128 z = _mm_mul_ps(x, x);
+
+        __m128 pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kCosP0), z), _mm_set1_ps(kCosP1));
+        pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(kCosP2));
+        pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+        pc = _mm_sub_ps(pc, _mm_mul_ps(_mm_set1_ps(0.5f), z));
+        pc = _mm_add_ps(pc, _mm_set1_ps(1.0f));
+
+        __m128 ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kSinP0), z), _mm_set1_ps(kSinP1));
+        ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(kSinP2));
+        ps = _mm_mul_ps(_mm_mul_ps(ps, z), x);
+        ps = _mm_add_ps(ps, x);
+
+        __m128 s = _mm_or_ps(_mm_and_ps(polyMask, ps), _mm_andnot_ps(polyMask, pc));
+        __m128 c = _mm_or_ps(_mm_and_ps(polyMask, pc), _mm_andnot_ps(polyMask, ps));
+        _mm_storeu_ps(sinOut + i, _mm_xor_ps(s, signSin));
+        _mm_storeu_ps(cosOut + i, _mm_xor_ps(c, signCos));
+    }
+    sincosScalar(angles + i, sinOut + i, cosOut + i, count - i);
+}
+
+// Sem "fma" de propósito: o GCC contrairia mul+add e os resultados deixariam
+// de bater com os caminhos escalar e SSE2.
+FAST_TRIG_TARGET("avx2")
+inline void sincosAVX2(const float* angles, float* sinOut, float* cosOut, std::size_t count) {
+    const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000u)));
+    const __m256i inv1 = _mm256_set1_epi32(~1);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i two = _mm256_set1_epi32(2);
+    const __m256i four = _mm256_set1_epi32(4);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(angles + i);
+        __m256 signSin = _mm256_and_ps(x, signMask);
+        x = _mm256_andnot_ps(signMask, x);
+
+        __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(kFourOverPi)));
+        j = _mm256_and_si256(_mm256_add_epi32(j, one), inv1);
+        __m256 y = _mm256_cvtepi32_ps(j);
+
+        __m256 swapSin = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, four), 29));
+        __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, two), four), 29));
+        __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, two), _mm256_setzero_si256()));
+        signSin = _mm256_xor_ps(signSin, swapSin);
+
+        x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(kDP1)));
+        x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(kDP2)));
+        x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(kDP3)));
+        __m256 z = _mm256_mul_ps(x, x);
+
+        __m256 pc = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(kCosP0), z), _mm256_set1_ps(kCosP1));
+        pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(kCosP2));
+        pc = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+        pc = _mm256_sub_ps(pc, _mm256_mul_ps(_mm256_set1_ps(0.5f), z));
+        pc = _mm256_add_ps(pc, _mm256_set1_ps(1.0f));
+
+        __m256 ps = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(kSinP0), z), _mm256_set1_ps(kSinP1));
+        ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(kSinP2));
+        ps = _mm256_mul_ps(_mm256_mul_ps(ps, z), x);
+        ps = _mm256_add_ps(ps, x);
+
+        __m256 s = _mm256_blendv_ps(pc, ps, polyMask);
+        __m256 c = _mm256_blendv_ps(ps, pc, polyMask);
+        _mm256_storeu_ps(sinOut + i, _mm256_xor_ps(s, signSin));
+        _mm256_storeu_ps(cosOut + i, _mm256_xor_ps(c, signCos));
+    }
+    sincosSSE2(angles + i, sinOut + i, cosOut + i, count - i);
+}
+
+#endif // FAST_TRIG_X86
+
+typedef void (*SinCosFn)(const float*, float*, float*, std::size_t);
+
+inline SinCosFn kernelFor(SimdLevel level) {
+#ifdef FAST_TRIG_X86
+    if (level == SimdLevel::AVX2) return sincosAVX2;
+    if (level == SimdLevel::SSE2) return sincosSSE2;
+#else
+    (void)level;
+#endif
+    return sincosScalar;
+}
+
+} // namespace detail
+
+// Maior nível SIMD suportado pela CPU atual
+inline SimdLevel detectSimdLevel() {
+#if defined(FAST_TRIG_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#elif defined(FAST_TRIG_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6) return SimdLevel::AVX2;
+    }
+    return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+// sinOut[i] = sin(angles[i]), cosOut[i] = cos(angles[i]) com um nível SIMD explícito
+inline void sincosBatch(const float* angles, float* sinOut, float* cosOut, std::size_t count, SimdLevel level) {
+    detail::kernelFor(level)(angles, sinOut, cosOut, count);
+}
+
+// Mesma coisa, usando o melhor kernel da CPU (detectado uma única vez)
+inline void sincosBatch(const float* angles, float* sinOut, float* cosOut, std::size_t count) {
+    static const detail::SinCosFn kernel = detail::kernelFor(detectSimdLevel());
+    kernel(angles, sinOut, cosOut, count);
+}
+
+// ---------------------------------------------------------------------------
+// Seno/cosseno constexpr (double), para tabelas geradas em tempo de compilação.
+// Reduz para [-pi, pi] e soma a série de Taylor; erro < 1e-12 para |x| < 1000.
+
+constexpr double kPi = 3.14159265358979323846;
+
+namespace detail {
+
+constexpr double reduceAngle(double x) {
+    double turns = x / (2.0 * kPi);
+    long long k = static_cast<long long>(turns >= 0.0 ? turns + 0.5 : turns - 0.5);
+    return x - static_cast<double>(k) * (2.0 * kPi);
+}
+
+} // namespace detail
+
+constexpr double constexprSin(double x) {
+    x = detail::reduceAngle(x);
+    double term = x, sum = x;
+    for (int n = 1; n < 14; n++) {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexprCos(double x) {
+    x = detail::reduceAngle(x);
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 14; n++) {
+        term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// ---------------------------------------------------------------------------
+// Rotação incremental (sem trigonometria por vértice)
+//
+// sin/cos de start + i*step, i = 0..count-1, gerados por multiplicação complexa:
+// 8 trilhas independentes começam em start + k*step e giram de 8*step por passo,
+// então o laço interno vetoriza. A magnitude é renormalizada a cada
+// kRenormInterval passos (uma iteração de Newton para 1/sqrt) e a fase é
+// ressincronizada com sincosBatch a cada resyncInterval passos.
+
+constexpr std::size_t kRotationLanes = 8;
+constexpr std::size_t kRenormInterval = 16;
+
+// Erro acumulado por passo de rotação, somado ao erro da avaliação direta
+// (4 * 2^-24; medido <= 3 * 2^-24 para varreduras de até 3 voltas)
+constexpr float kRotationErrorPerStep = 4.0f * 5.9604645e-8f;
+
+// Maior intervalo de ressincronização que mantém |erro| <= maxError
+constexpr std::size_t resyncIntervalFor(float maxError) {
+    float steps = maxError / kRotationErrorPerStep;
+    if (!(steps >= 1.0f)) return 1;
+    if (steps > 1.0e9f) return 1000000000;
+    return static_cast<std::size_t>(steps);
+}
+
+// Tolerância maior => ressincronização mais rara (é o que torna o modo mais rápido)
+static_assert(resyncIntervalFor(1e-5f) < resyncIntervalFor(1e-3f), "intervalo deve crescer com a tolerância");
+static_assert(resyncIntervalFor(1e-3f) <= 1e-3f / kRotationErrorPerStep, "intervalo acima do limite de erro");
+
+// Estado da rotação incremental, para gerar uma varredura em vários pedaços
+// sem reiniciar a fase (e sem buffer do tamanho da varredura inteira)
+struct RotationState {
+    float start = 0.0f, step = 0.0f;
+    float rc = 1.0f, rs = 0.0f;       // rotação de kRotationLanes passos
+    std::size_t resyncInterval = 1;
+    std::size_t sinceResync = 0;
+    std::size_t index = 0;            // próximo índice da varredura
+    float s[kRotationLanes] = {}, c[kRotationLanes] = {};
+};
+
+inline RotationState beginRotation(float start, float step, std::size_t resyncInterval) {
+    RotationState state;
+    state.start = start;
+    state.step = step;
+    double stride = static_cast<double>(step) * kRotationLanes;
+    state.rc = static_cast<float>(std::cos(stride));
+    state.rs = static_cast<float>(std::sin(stride));
+    state.resyncInterval = resyncInterval == 0 ? 1 : resyncInterval;
+    state.sinceResync = state.resyncInterval;  // a primeira trilha sai da avaliação direta
+    return state;
+}
+
+// Próximos count valores da varredura. count deve ser múltiplo de
+// kRotationLanes, exceto no último pedaço.
+inline void continueRotation(RotationState& state, std::size_t count, float* sinOut, float* cosOut) {
+    const std::size_t lanes = kRotationLanes;
+    float angles[lanes];
+    float* s = state.s;
+    float* c = state.c;
+
+    for (std::size_t base = 0; base < count; base += lanes) {
+        if (state.sinceResync >= state.resyncInterval) {
+            for (std::size_t k = 0; k < lanes; k++)
+                angles[k] = static_cast<float>(state.start + static_cast<double>(state.step) * (state.index + base + k));
+            sincosBatch(angles, s, c, lanes);
+            state.sinceResync = 0;
+        } else {
+            for (std::size_t k = 0; k < lanes; k++) {
+                float cn = c[k] * state.rc - s[k] * state.rs;
+                float sn = s[k] * state.rc + c[k] * state.rs;
+                c[k] = cn;
+                s[k] = sn;
+            }
+            if (state.sinceResync % kRenormInterval == 0) {
+                for (std::size_t k = 0; k < lanes; k++) {
+                    float g = 1.5f - 0.5f * (c[k] * c[k] + s[k] * s[k]);
+                    c[k] *= g;
+                    s[k] *= g;
+                }
+            }
+        }
+        state.sinceResync++;
+
+        std::size_t n = count - base < lanes ? count - base : lanes;
+        for (std::size_t k = 0; k < n; k++) {
+            sinOut[base + k] = s[k];
+            cosOut[base + k] = c[k];
+        }
+    }
+    state.index += count;
+}
+
+inline void sincosIncremental(float start, float step, std::size_t count, float* sinOut, float* cosOut,
+                              std::size_t resyncInterval) {
+    RotationState state = beginRotation(start, step, resyncInterval);
+    continueRotation(state, count, sinOut, cosOut);
+}
+
+} // namespace fasttrig
+
+#endif // FAST_TRIG_H
@@ -0,0 +1,132 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+// Ritmo de quadros, escolhido na linha de comando:
+//   --vsync            (padrão) glfwSwapInterval(1): um quadro por atualização do monitor
+//   --uncapped         glfwSwapInterval(0), sem limite; imprime FPS e tempo de quadro (benchmark)
+//   --fps N            glfwSwapInterval(0) e limitador em N quadros por segundo: dorme até
+//                      perto do prazo e termina em espera ativa, para não depender da
+//                      granularidade do sleep do sistema
+//   --max-frames N     no máximo N quadros enfileirados na GPU (1 a 4). Depois de cada swap
+//                      entra uma fence; antes de passar adiante, espera a fence de N quadros
+//                      atrás. Limita a latência entre entrada e imagem quando a CPU está à
+//                      frente da GPU. Sem a opção, vale o limite do driver.
+//
+// Uso: createFramePacer depois de glfwMakeContextCurrent e da GLAD; no loop,
+// presentFrame(pacer, window) no lugar de glfwSwapBuffers(window).
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+enum class PacingMode { VSync, Uncapped, Limited };
+
+struct FramePacer {
+    static const int kMaxFramesInFlight = 4;
+    using Clock = std::chrono::steady_clock;
+
+    PacingMode mode = PacingMode::VSync;
+    double targetFps = 60.0;
+    int maxFramesInFlight = 0;  // 0 = sem fences, limite do driver
+    GLsync fences[kMaxFramesInFlight] = {};
+    unsigned long long frame = 0;
+
+    Clock::time_point nextDeadline;   // limitador
+    Clock::time_point reportStart;    // benchmark
+    unsigned long long reportFrames = 0;
+};
+
+inline FramePacer createFramePacer(int argc, char** argv) {
+    FramePacer pacer;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--vsync") == 0) {
+            pacer.mode = PacingMode::VSync;
+        } else if (std::strcmp(argv[i], "--uncapped") == 0) {
+            pacer.mode = PacingMode::Uncapped;
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            pacer.mode = PacingMode::Limited;
+            pacer.targetFps = std::max(1.0, std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-frames") == 0 && i + 1 < argc) {
+            pacer.maxFramesInFlight = std::clamp(std::atoi(argv[++i]), 1, FramePacer::kMaxFramesInFlight);
+        }
+    }
+
+    glfwSwapInterval(pacer.mode == PacingMode::VSync ? 1 : 0);
+    pacer.nextDeadline = FramePacer::Clock::now();
+    pacer.reportStart = FramePacer::Clock::now();
+    return pacer;
+}
+
+inline void deleteFramePacer(FramePacer& pacer) {
+    for (GLsync& fence : pacer.fences) {
+        if (fence) glDeleteSync(fence);
+        fence = 0;
+    }
+}
+
+namespace framepacing::detail {
+
+// Dorme até ~2 ms antes do prazo e completa em espera ativa
+inline void sleepThenSpin(FramePacer::Clock::time_point deadline) {
+    const auto spinMargin = std::chrono::milliseconds(2);
+    auto now = FramePacer::Clock::now();
+    if (deadline - now > spinMargin)
+        std::this_thread::sleep_for(deadline - now - spinMargin);
+    while (FramePacer::Clock::now() < deadline) {}
+}
+
+inline void limitFrameRate(FramePacer& pacer) {
+    auto period = std::chrono::duration_cast<FramePacer::Clock::duration>(
+        std::chrono::duration<double>(1.0 / pacer.targetFps));
+    pacer.nextDeadline += period;
+    auto now = FramePacer::Clock::now();
+    //Atrasado mais de um quadro (janela arrastada, breakpoint...): recomeça do
+    //agora em vez de emendar quadros para recuperar
+    if (now > pacer.nextDeadline + period) {
+        pacer.nextDeadline = now;
+        return;
+    }
+    sleepThenSpin(pacer.nextDeadline);
+}
+
+inline void reportFrameRate(FramePacer& pacer) {
+    pacer.reportFrames++;
+    auto now = FramePacer::Clock::now();
+    double elapsed = std::chrono::duration<double>(now - pacer.reportStart).count();
+    if (elapsed < 1.0) return;
+    std::cout << "FPS: " << pacer.reportFrames / elapsed
+              << " (" << 1000.0 * elapsed / pacer.reportFrames << " ms/quadro)" << std::endl;
+    pacer.reportStart = now;
+    pacer.reportFrames = 0;
+}
+
+} // namespace framepacing::detail
+
+// Apresenta o quadro e aplica o ritmo escolhido
+inline void presentFrame(FramePacer& pacer, GLFWwindow* window) {
+    glfwSwapBuffers(window);
+
+    if (pacer.maxFramesInFlight > 0) {
+        //A posição do anel guarda a fence de maxFramesInFlight quadros atrás
+        GLsync& fence = pacer.fences[pacer.frame % pacer.maxFramesInFlight];
+        if (fence) {
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    pacer.frame++;
+
+    if (pacer.mode == PacingMode::Limited)
+        framepacing::detail::limitFrameRate(pacer);
+    else if (pacer.mode == PacingMode::Uncapped)
+        framepacing::detail::reportFrameRate(pacer);
+}
+
+#endif // FRAME_PACING_H
@@ -0,0 +1,158 @@
+#ifndef GEOMETRY_POOL_H
+#define GEOMETRY_POOL_H
+
+// Pool de geometria estática: todas as formas num único VBO (e EBO) sob um
+// único VAO.
+//
+// Cada forma adicionada vira uma faixa do pool (primeiro vértice, contagem e,
+// para malhas indexadas, offset dos índices e vértice base). As faixas são
+// agrupadas em listas de desenho por primitiva, e cada lista sai numa única
+// chamada: glMultiDrawArrays para formas não indexadas e
+// glMultiDrawElementsBaseVertex para as indexadas. Isso troca N pares
+// bind + draw por quadro por um bind e uma chamada por lista.
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gl_state.h>
+
+struct PoolRange {
+    GLint first = 0;             // primeiro vértice (não indexada) ou vértice base (indexada)
+    GLsizei count = 0;           // vértices (não indexada) ou índices (indexada)
+    std::size_t indexOffset = 0; // em bytes no EBO (indexada)
+    bool indexed = false;
+};
+
+struct GeometryPool {
+    GLuint VAO = 0, VBO = 0, EBO = 0;
+    std::vector<float> vertices;         // x, y, z; cópia na CPU até uploadPool
+    std::vector<std::uint32_t> indices;  // relativos ao vértice base de cada forma
+    std::vector<PoolRange> ranges;
+};
+
+// Lista de formas do pool desenhadas com a mesma primitiva
+struct PoolDrawList {
+    GLenum mode = GL_TRIANGLES;
+    bool indexed = false;
+    std::vector<GLint> first;            // glMultiDrawArrays / vértice base
+    std::vector<GLsizei> count;
+    std::vector<const void*> offsets;    // glMultiDrawElementsBaseVertex
+};
+
+// Acrescenta vertexCount vértices não indexados; retorna o identificador da forma
+inline int addPoolArrays(GeometryPool& pool, const float* vertices, std::size_t vertexCount) {
+    PoolRange range;
+    range.first = static_cast<GLint>(pool.vertices.size() / 3);
+    range.count = static_cast<GLsizei>(vertexCount);
+    pool.vertices.insert(pool.vertices.end(), vertices, vertices + 3 * vertexCount);
+    pool.ranges.push_back(range);
+    return static_cast<int>(pool.ranges.size() - 1);
+}
+
+inline int addPoolArrays(GeometryPool& pool, const std::vector<float>& vertices) {
+    return addPoolArrays(pool, vertices.data(), vertices.size() / 3);
+}
+
+// Acrescenta uma malha indexada; os índices começam em 0 no primeiro vértice dela
+inline int addPoolIndexed(GeometryPool& pool, const float* vertices, std::size_t vertexCount,
+                          const std::uint32_t* indices, std::size_t indexCount) {
+    PoolRange range;
+    range.first = static_cast<GLint>(pool.vertices.size() / 3);
+    range.count = static_cast<GLsizei>(indexCount);
+    range.indexOffset = pool.indices.size() * sizeof(std::uint32_t);
+    range.indexed = true;
+    pool.vertices.insert(pool.vertices.end(), vertices, vertices + 3 * vertexCount);
+    pool.indices.insert(pool.indices.end(), indices, indices + indexCount);
+    pool.ranges.push_back(range);
+    return static_cast<int>(pool.ranges.size() - 1);
+}
+
+// Cria (na primeira chamada) ou reenvia VBO e EBO com tudo o que foi adicionado
+inline void uploadPool(GeometryPool& pool, GLenum usage = GL_STATIC_DRAW) {
+    if (pool.VAO == 0) {
+        glGenVertexArrays(1, &pool.VAO);
+        glGenBuffers(1, &pool.VBO);
+        glGenBuffers(1, &pool.EBO);
+    }
+
+    glstate::bindVertexArray(pool.VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+    glBufferData(GL_ARRAY_BUFFER, pool.vertices.size() * sizeof(float), pool.vertices.data(), usage);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glstate::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, pool.indices.size() * sizeof(std::uint32_t), pool.indices.data(), usage);
+
+    glstate::bindVertexArray(0);
+}
+
+// Remove todas as formas (mantém os objetos GL e a memória da CPU)
+inline void clearPool(GeometryPool& pool) {
+    pool.vertices.clear();
+    pool.indices.clear();
+    pool.ranges.clear();
+}
+
+inline void deletePool(GeometryPool& pool) {
+    glstate::onDeleteVertexArray(pool.VAO);
+    glstate::onDeleteBuffer(pool.VBO);
+    glstate::onDeleteBuffer(pool.EBO);
+    glDeleteVertexArrays(1, &pool.VAO);
+    glDeleteBuffers(1, &pool.VBO);
+    glDeleteBuffers(1, &pool.EBO);
+    pool = GeometryPool();
+}
+
+// Acrescenta uma forma do pool à lista; todas as formas de uma lista precisam
+// ser do mesmo tipo (indexadas ou não)
+inline void addToDrawList(PoolDrawList& list, const GeometryPool& pool, int shape) {
+    const PoolRange& range = pool.ranges[shape];
+    list.indexed = range.indexed;
+    list.first.push_back(range.first);
+    list.count.push_back(range.count);
+    list.offsets.push_back((const void*)range.indexOffset);
+}
+
+// Acrescenta n formas não indexadas que já estão juntas em vertices, com
+// first/count relativos ao início de vertices (a saída de generateShapesBulk),
+// e põe todas na lista
+inline void addPoolArraysToDrawList(PoolDrawList& list, GeometryPool& pool, const float* vertices,
+                                    std::size_t vertexCount, const int* first, const int* count, std::size_t n) {
+    GLint base = static_cast<GLint>(pool.vertices.size() / 3);
+    pool.vertices.insert(pool.vertices.end(), vertices, vertices + 3 * vertexCount);
+    for (std::size_t i = 0; i < n; i++) {
+        PoolRange range;
+        range.first = base + first[i];
+        range.count = count[i];
+        pool.ranges.push_back(range);
+        addToDrawList(list, pool, static_cast<int>(pool.ranges.size() - 1));
+    }
+}
+
+inline void clearDrawList(PoolDrawList& list) {
+    list.first.clear();
+    list.count.clear();
+    list.offsets.clear();
+}
+
+inline void bindPool(const GeometryPool& pool) {
+    glstate::bindVertexArray(pool.VAO);
+}
+
+// Uma chamada para todas as formas da lista; o VAO do pool deve estar ligado
+inline void drawPoolList(const PoolDrawList& list) {
+    GLsizei drawCount = static_cast<GLsizei>(list.count.size());
+    if (drawCount == 0) return;
+    if (list.indexed) {
+        glMultiDrawElementsBaseVertex(list.mode, list.count.data(), GL_UNSIGNED_INT,
+                                      list.offsets.data(), drawCount, const_cast<GLint*>(list.first.data()));
+    } else {
+        glMultiDrawArrays(list.mode, list.first.data(), list.count.data(), drawCount);
+    }
+}
+
+#endif // GEOMETRY_POOL_H
@@ -0,0 +1,186 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+// Cache do estado do GL para eliminar chamadas redundantes.
+//
+// Guarda uma cópia (shadow state) do programa em uso, do VAO, dos buffers
+// ligados em GL_ARRAY_BUFFER e GL_ELEMENT_ARRAY_BUFFER, do polygon mode, do
+// tamanho de ponto, do blend (ligado, fatores e equação), da máscara de cor e
+// do reinício de primitiva. Cada função só chama o GL se o valor pedido for
+// diferente do último enviado; as chamadas evitadas são contadas.
+//
+// O cache só é correto se todas as mudanças desse estado passarem por ele. Os
+// headers compartilhados usam estas funções. Código que chamar o GL direto
+// deve chamar glstate::invalidate() depois. Deleções de objetos ligados devem
+// ser avisadas com onDelete*, já que o GL desfaz a ligação sozinho.
+//
+// O estado começa desconhecido: a primeira chamada de cada tipo sempre vai
+// para o GL. O cache é thread_local, como o contexto corrente.
+
+#include <glad/glad.h>
+
+#include <array>
+#include <optional>
+
+namespace glstate {
+
+struct Stats {
+    unsigned long long issued = 0;   // chamadas enviadas ao GL
+    unsigned long long skipped = 0;  // chamadas redundantes evitadas
+};
+
+namespace detail {
+
+struct State {
+    std::optional<GLuint> program;
+    std::optional<GLuint> vertexArray;
+    std::optional<GLuint> arrayBuffer;
+    std::optional<GLuint> elementBuffer;  // parte do estado do VAO
+    std::optional<GLenum> polygonMode;
+    std::optional<float> pointSize;
+    std::optional<bool> blend;
+    std::optional<std::array<GLenum, 4>> blendFactors;  // origem e destino da cor, depois do alfa
+    std::optional<GLenum> blendEquation;
+    std::optional<std::array<bool, 4>> colorMask;
+    std::optional<bool> primitiveRestart;
+    std::optional<GLuint> restartIndex;
+    Stats stats;
+};
+
+inline State& state() {
+    thread_local State current;
+    return current;
+}
+
+// true se o valor mudou (e atualiza o cache); conta a chamada evitada se não
+template <typename T>
+bool update(std::optional<T>& cached, T value) {
+    State& s = state();
+    if (cached && *cached == value) {
+        s.stats.skipped++;
+        return false;
+    }
+    cached = value;
+    s.stats.issued++;
+    return true;
+}
+
+} // namespace detail
+
+inline void useProgram(GLuint program) {
+    if (detail::update(detail::state().program, program))
+        glUseProgram(program);
+}
+
+inline void bindVertexArray(GLuint vertexArray) {
+    detail::State& s = detail::state();
+    if (detail::update(s.vertexArray, vertexArray)) {
+        glBindVertexArray(vertexArray);
+        s.elementBuffer.reset(); //o EBO ligado é o do novo VAO, que não acompanhamos
+    }
+}
+
+// GL_ARRAY_BUFFER e GL_ELEMENT_ARRAY_BUFFER são cacheados; outros alvos passam direto
+inline void bindBuffer(GLenum target, GLuint buffer) {
+    detail::State& s = detail::state();
+    std::optional<GLuint>* cached = target == GL_ARRAY_BUFFER ? &s.arrayBuffer
+                                  : target == GL_ELEMENT_ARRAY_BUFFER ? &s.elementBuffer : nullptr;
+    if (!cached) {
+        s.stats.issued++;
+        glBindBuffer(target, buffer);
+    } else if (detail::update(*cached, buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+// O core profile só aceita GL_FRONT_AND_BACK
+inline void polygonMode(GLenum mode) {
+    if (detail::update(detail::state().polygonMode, mode))
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+inline void pointSize(float size) {
+    if (detail::update(detail::state().pointSize, size))
+        glPointSize(size);
+}
+
+inline void setBlend(bool enabled) {
+    if (detail::update(detail::state().blend, enabled)) {
+        if (enabled) glEnable(GL_BLEND);
+        else glDisable(GL_BLEND);
+    }
+}
+
+inline void blendFunc(GLenum src, GLenum dst) {
+    if (detail::update(detail::state().blendFactors, std::array<GLenum, 4>{src, dst, src, dst}))
+        glBlendFunc(src, dst);
+}
+
+inline void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    if (detail::update(detail::state().blendFactors, std::array<GLenum, 4>{srcRGB, dstRGB, srcAlpha, dstAlpha}))
+        glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+// GL_FUNC_ADD (padrão do GL), GL_MIN, GL_MAX, ...
+inline void blendEquation(GLenum mode) {
+    if (detail::update(detail::state().blendEquation, mode))
+        glBlendEquation(mode);
+}
+
+inline void colorMask(bool r, bool g, bool b, bool a) {
+    if (detail::update(detail::state().colorMask, std::array<bool, 4>{r, g, b, a}))
+        glColorMask(r, g, b, a);
+}
+
+inline void setPrimitiveRestart(bool enabled) {
+    if (detail::update(detail::state().primitiveRestart, enabled)) {
+        if (enabled) glEnable(GL_PRIMITIVE_RESTART);
+        else glDisable(GL_PRIMITIVE_RESTART);
+    }
+}
+
+inline void primitiveRestartIndex(GLuint index) {
+    if (detail::update(detail::state().restartIndex, index))
+        glPrimitiveRestartIndex(index);
+}
+
+// O GL desliga um VAO ou buffer deletado enquanto ligado
+inline void onDeleteVertexArray(GLuint vertexArray) {
+    detail::State& s = detail::state();
+    if (s.vertexArray && *s.vertexArray == vertexArray) {
+        s.vertexArray = 0u;
+        s.elementBuffer.reset();
+    }
+}
+
+inline void onDeleteBuffer(GLuint buffer) {
+    detail::State& s = detail::state();
+    if (s.arrayBuffer && *s.arrayBuffer == buffer) s.arrayBuffer = 0u;
+    if (s.elementBuffer && *s.elementBuffer == buffer) s.elementBuffer.reset();
+}
+
+// Um programa em uso continua em uso depois de deletado, mas o nome pode ser
+// reaproveitado: esquecemos o valor
+inline void onDeleteProgram(GLuint program) {
+    detail::State& s = detail::state();
+    if (s.program && *s.program == program) s.program.reset();
+}
+
+// Depois de mudar o estado com chamadas diretas ao GL
+inline void invalidate() {
+    Stats stats = detail::state().stats;
+    detail::state() = detail::State();
+    detail::state().stats = stats;
+}
+
+inline Stats stats() {
+    return detail::state().stats;
+}
+
+inline void resetStats() {
+    detail::state().stats = Stats();
+}
+
+} // namespace glstate
+
+#endif // GL_STATE_H
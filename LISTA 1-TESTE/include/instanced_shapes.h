@@ -0,0 +1,133 @@
+#ifndef INSTANCED_SHAPES_H
+#define INSTANCED_SHAPES_H
+
+// Desenho instanciado de formas regulares repetidas.
+//
+// Cada classe de forma (círculo, octógono, estrela...) tem uma malha unitária,
+// centrada na origem com raio 1, e um buffer de instâncias com centro, raio,
+// rotação e cor. glVertexAttribDivisor(1) faz esses atributos avançarem uma
+// vez por instância, e glDrawArraysInstanced desenha todas as cópias numa só
+// chamada: 100k círculos viram um draw, não 100k.
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+#include <gl_state.h>
+#include <shader_cache.h>
+#include <shapes.h>
+
+struct ShapeInstance {
+    float centerX, centerY;
+    float radius;
+    float rotation;    // radianos, anti-horário
+    float r, g, b, a;  // cor
+};
+
+namespace instancedshapes::detail {
+
+const char* const kInstancedVertexShader = R"(
+    #version 330 core
+    layout (location = 0) in vec3 aPos;       // malha unitária
+    layout (location = 1) in vec4 aTransform; // centro.xy, raio, rotação
+    layout (location = 2) in vec4 aColor;
+    out vec4 vertexColor;
+    void main() {
+        float c = cos(aTransform.w);
+        float s = sin(aTransform.w);
+        vec2 p = aPos.xy * aTransform.z;
+        gl_Position = vec4(vec2(c * p.x - s * p.y, s * p.x + c * p.y) + aTransform.xy, 0.0, 1.0);
+        vertexColor = aColor;
+    }
+)";
+
+const char* const kInstancedFragmentShader = R"(
+    #version 330 core
+    in vec4 vertexColor;
+    out vec4 FragColor;
+    void main() {
+        FragColor = vertexColor;
+    }
+)";
+
+} // namespace instancedshapes::detail
+
+// Programa compartilhado por todas as classes de forma (do cache de shaders)
+inline GLuint createInstancedShapeProgram() {
+    return getCachedProgram(instancedshapes::detail::kInstancedVertexShader, instancedshapes::detail::kInstancedFragmentShader);
+}
+
+struct InstancedShapeClass {
+    GLuint VAO = 0, meshVBO = 0, instanceVBO = 0;
+    GLsizei vertexCount = 0;
+    GLsizei instanceCount = 0;
+    GLenum mode = GL_TRIANGLE_FAN;
+};
+
+// Cria a classe a partir de uma malha unitária (x, y, z por vértice), por
+// exemplo uma tabela de generatePolygonVertices<N>() ou um leque escrito com raio 1
+inline InstancedShapeClass createInstancedShapeClass(const float* unitVertices, std::size_t vertexCount,
+                                                     GLenum mode = GL_TRIANGLE_FAN) {
+    InstancedShapeClass shape;
+    shape.vertexCount = static_cast<GLsizei>(vertexCount);
+    shape.mode = mode;
+
+    glGenVertexArrays(1, &shape.VAO);
+    glGenBuffers(1, &shape.meshVBO);
+    glGenBuffers(1, &shape.instanceVBO);
+
+    glstate::bindVertexArray(shape.VAO);
+
+    //Malha unitária (location = 0)
+    glstate::bindBuffer(GL_ARRAY_BUFFER, shape.meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 3 * sizeof(float), unitVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    //Atributos por instância (location = 1: transformação, location = 2: cor)
+    glstate::bindBuffer(GL_ARRAY_BUFFER, shape.instanceVBO);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance), (void*)offsetof(ShapeInstance, centerX));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance), (void*)offsetof(ShapeInstance, r));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glstate::bindVertexArray(0);
+    return shape;
+}
+
+inline InstancedShapeClass createInstancedShapeClass(const std::vector<float>& unitVertices, GLenum mode = GL_TRIANGLE_FAN) {
+    return createInstancedShapeClass(unitVertices.data(), unitVertices.size() / 3, mode);
+}
+
+// Substitui as instâncias da classe (GL_DYNAMIC_DRAW: pensado para mudar com frequência)
+inline void setInstances(InstancedShapeClass& shape, const ShapeInstance* instances, std::size_t count) {
+    glstate::bindBuffer(GL_ARRAY_BUFFER, shape.instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(ShapeInstance), instances, GL_DYNAMIC_DRAW);
+    shape.instanceCount = static_cast<GLsizei>(count);
+}
+
+inline void setInstances(InstancedShapeClass& shape, const std::vector<ShapeInstance>& instances) {
+    setInstances(shape, instances.data(), instances.size());
+}
+
+// Uma chamada para todas as instâncias; o programa de createInstancedShapeProgram deve estar em uso
+inline void drawInstanced(const InstancedShapeClass& shape) {
+    if (shape.instanceCount == 0) return;
+    glstate::bindVertexArray(shape.VAO);
+    glDrawArraysInstanced(shape.mode, 0, shape.vertexCount, shape.instanceCount);
+}
+
+inline void deleteInstancedShapeClass(InstancedShapeClass& shape) {
+    glstate::onDeleteVertexArray(shape.VAO);
+    glstate::onDeleteBuffer(shape.meshVBO);
+    glstate::onDeleteBuffer(shape.instanceVBO);
+    glDeleteVertexArrays(1, &shape.VAO);
+    glDeleteBuffers(1, &shape.meshVBO);
+    glDeleteBuffers(1, &shape.instanceVBO);
+    shape = InstancedShapeClass();
+}
+
+#endif // INSTANCED_SHAPES_H
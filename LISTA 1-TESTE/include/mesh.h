@@ -0,0 +1,184 @@
+#ifndef MESH_H
+#define MESH_H
+
+// Malha indexada (posições + índices) e o caminho de desenho com EBO.
+//
+// Os geradores de formas produzem leques (GL_TRIANGLE_FAN) que não podem ser
+// concatenados num único glDrawArrays. Convertidos em triângulos indexados,
+// vários leques cabem no mesmo VBO/EBO e saem numa única chamada de
+// glDrawElements; vértices repetidos (fechamento do leque, cantos de quads)
+// são guardados uma vez só.
+//
+// Alternativa sem converter: leques e faixas indexados como tais, separados
+// pelo índice de reinício de primitiva (GL 3.1). Cada leque custa n + 1
+// índices em vez de 3 * (n - 2), e todos saem num único
+// glDrawElements(GL_TRIANGLE_FAN, ...); o mesmo vale para várias polilinhas
+// com GL_LINE_STRIP. Uma malha deve usar só um dos dois formatos.
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gl_state.h>
+
+struct IndexedMesh {
+    std::vector<float> positions;        // x, y, z por vértice
+    std::vector<std::uint32_t> indices;  // triângulos, ou leques/faixas separados por kRestartIndex
+    bool usesRestart = false;
+
+    // Separador de primitivas; vira 0xFFFF quando os índices vão em 16 bits
+    static constexpr std::uint32_t kRestartIndex = 0xFFFFFFFFu;
+
+    std::size_t vertexCount() const { return positions.size() / 3; }
+
+    // Acrescenta vértices e índices já relativos a eles (índice 0 = primeiro vértice acrescentado)
+    void appendTriangles(const float* vertices, std::size_t count, const std::uint32_t* triangleIndices, std::size_t indexCount) {
+        std::uint32_t base = static_cast<std::uint32_t>(vertexCount());
+        positions.insert(positions.end(), vertices, vertices + 3 * count);
+        for (std::size_t i = 0; i < indexCount; i++)
+            indices.push_back(base + triangleIndices[i]);
+    }
+
+    // Acrescenta um leque no formato dos geradores: centro seguido do contorno.
+    // Se closed, o último vértice do contorno repete o primeiro (polígonos,
+    // estrelas): ele é descartado e o último triângulo volta ao primeiro vértice.
+    void appendFan(const float* fan, std::size_t fanCount, bool closed) {
+        if (fanCount < 3) return;
+        std::size_t rimCount = fanCount - 1;
+        std::size_t keptCount = closed ? fanCount - 1 : fanCount;
+
+        std::uint32_t base = static_cast<std::uint32_t>(vertexCount());
+        positions.insert(positions.end(), fan, fan + 3 * keptCount);
+        for (std::size_t i = 1; i < rimCount; i++) {
+            std::uint32_t next = (closed && i + 1 == rimCount) ? 1 : static_cast<std::uint32_t>(i + 1);
+            indices.push_back(base);
+            indices.push_back(base + static_cast<std::uint32_t>(i));
+            indices.push_back(base + next);
+        }
+    }
+
+    void appendFan(const std::vector<float>& fan, bool closed) {
+        appendFan(fan.data(), fan.size() / 3, closed);
+    }
+
+    // Acrescenta um leque para GL_TRIANGLE_FAN com reinício de primitiva. Se
+    // closed, o vértice repetido é descartado e o leque fecha no índice 1.
+    void appendRestartFan(const float* fan, std::size_t fanCount, bool closed) {
+        if (fanCount < 3) return;
+        std::size_t keptCount = closed ? fanCount - 1 : fanCount;
+        appendRestartPrimitive(fan, keptCount);
+        if (closed)
+            indices.push_back(static_cast<std::uint32_t>(vertexCount() - keptCount + 1));
+    }
+
+    // Acrescenta uma faixa (GL_LINE_STRIP, GL_TRIANGLE_STRIP) com reinício de primitiva
+    void appendRestartStrip(const float* strip, std::size_t count) {
+        if (count < 2) return;
+        appendRestartPrimitive(strip, count);
+    }
+
+    void appendRestartPrimitive(const float* vertices, std::size_t count) {
+        if (!indices.empty())
+            indices.push_back(kRestartIndex);
+        usesRestart = true;
+        std::uint32_t base = static_cast<std::uint32_t>(vertexCount());
+        positions.insert(positions.end(), vertices, vertices + 3 * count);
+        for (std::size_t i = 0; i < count; i++)
+            indices.push_back(base + static_cast<std::uint32_t>(i));
+    }
+
+    // Mantém a capacidade: reconstruir a malha a cada quadro não realoca
+    void clear() {
+        positions.clear();
+        indices.clear();
+        usesRestart = false;
+    }
+};
+
+// Malha na GPU: um VAO com VBO de posições (location = 0) e EBO.
+// Os índices vão como GL_UNSIGNED_SHORT quando todos os vértices cabem em 16 bits.
+struct GpuMesh {
+    GLuint VAO = 0, VBO = 0, EBO = 0;
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    bool primitiveRestart = false;
+};
+
+namespace mesh::detail {
+
+inline void convertIndices16(const std::vector<std::uint32_t>& indices, std::uint16_t* shortIndices) {
+    for (std::size_t i = 0; i < indices.size(); i++)
+        shortIndices[i] = indices[i] == IndexedMesh::kRestartIndex ? 0xFFFF : static_cast<std::uint16_t>(indices[i]);
+}
+
+} // namespace mesh::detail
+
+// Cria (na primeira chamada) ou reenvia a malha para a GPU
+inline void uploadMesh(GpuMesh& gpu, const IndexedMesh& mesh, GLenum usage = GL_STATIC_DRAW) {
+    if (gpu.VAO == 0) {
+        glGenVertexArrays(1, &gpu.VAO);
+        glGenBuffers(1, &gpu.VBO);
+        glGenBuffers(1, &gpu.EBO);
+    }
+
+    glstate::bindVertexArray(gpu.VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, gpu.VBO);
+    glBufferData(GL_ARRAY_BUFFER, mesh.positions.size() * sizeof(float), mesh.positions.data(), usage);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    //O EBO fica associado ao VAO
+    glstate::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.EBO);
+    //Com reinício de primitiva, 0xFFFF é o separador e não pode ser um vértice
+    if (mesh.usesRestart ? mesh.vertexCount() < 0xFFFF : mesh.vertexCount() <= 0x10000) {
+        //Converte para 16 bits direto no buffer mapeado, sem cópia intermediária
+        GLsizeiptr size = mesh.indices.size() * sizeof(std::uint16_t);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, nullptr, usage);
+        if (size > 0) {
+            std::uint16_t* shortIndices = (std::uint16_t*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, size,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            bool written = false;
+            if (shortIndices) {
+                mesh::detail::convertIndices16(mesh.indices, shortIndices);
+                //GL_FALSE: o conteúdo foi perdido enquanto mapeado e precisa ser reenviado
+                written = glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER) == GL_TRUE;
+            }
+            if (!written) {
+                //Mapeamento indisponível: converte numa cópia e envia com glBufferData
+                std::vector<std::uint16_t> staging(mesh.indices.size());
+                mesh::detail::convertIndices16(mesh.indices, staging.data());
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, staging.data(), usage);
+            }
+        }
+        gpu.indexType = GL_UNSIGNED_SHORT;
+    } else {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(std::uint32_t), mesh.indices.data(), usage);
+        gpu.indexType = GL_UNSIGNED_INT;
+    }
+    gpu.indexCount = static_cast<GLsizei>(mesh.indices.size());
+    gpu.primitiveRestart = mesh.usesRestart;
+
+    glstate::bindVertexArray(0);
+}
+
+inline void drawMesh(const GpuMesh& gpu, GLenum mode = GL_TRIANGLES) {
+    glstate::bindVertexArray(gpu.VAO);
+    glstate::setPrimitiveRestart(gpu.primitiveRestart);
+    if (gpu.primitiveRestart)
+        glstate::primitiveRestartIndex(gpu.indexType == GL_UNSIGNED_SHORT ? 0xFFFFu : IndexedMesh::kRestartIndex);
+    glDrawElements(mode, gpu.indexCount, gpu.indexType, (void*)0);
+}
+
+inline void deleteMesh(GpuMesh& gpu) {
+    glstate::onDeleteVertexArray(gpu.VAO);
+    glstate::onDeleteBuffer(gpu.VBO);
+    glstate::onDeleteBuffer(gpu.EBO);
+    glDeleteVertexArrays(1, &gpu.VAO);
+    glDeleteBuffers(1, &gpu.VBO);
+    glDeleteBuffers(1, &gpu.EBO);
+    gpu = GpuMesh();
+}
+
+#endif // MESH_H
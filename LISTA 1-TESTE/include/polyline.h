@@ -0,0 +1,203 @@
+#ifndef POLYLINE_H
+#define POLYLINE_H
+
+// Polilinhas grossas com anti-aliasing, expandidas no vertex shader.
+//
+// No core profile glLineWidth só garante 1 pixel. Aqui cada segmento vira uma
+// instância de um quad (GL_TRIANGLE_STRIP de 4 vértices): os dois extremos do
+// segmento são lidos do próprio VBO da polilinha, com o mesmo buffer ligado
+// em dois atributos com divisor 1 (o ponto i e o ponto i + 1). O shader
+// converte os extremos para pixels e abre o quad na perpendicular, com meia
+// largura + 1 pixel de margem. O fragment shader calcula a distância do pixel
+// ao segmento (uma cápsula, o que já arredonda as junções) e transforma em
+// cobertura para o blend.
+//
+// Cápsulas vizinhas se sobrepõem em cada junção. Com um blend comum, a borda
+// suavizada (e a linha inteira, se a < 1) seria composta duas vezes ali,
+// deixando "contas" ao longo da curva. Por isso o desenho tem duas passadas:
+//   1. só o alfa do destino, com GL_MIN: alfa = 1 - maior cobertura do pixel;
+//   2. a cor, com fator 1 - alfa do destino, escrevendo alfa 1: o primeiro
+//      fragmento de cada pixel compõe com a cobertura máxima e os seguintes
+//      não mudam nada.
+// O alfa do destino deve ser 1 onde a linha passa (glClear com alfa 1) e
+// volta a ser 1 no fim. Sem canal alfa no framebuffer, fica o blend comum.
+//
+// A entrada continua sendo um ponto por vértice, o mesmo VBO de
+// GL_LINE_STRIP; nada de 6 vértices por segmento montados na CPU.
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+#include <gl_state.h>
+#include <shader_cache.h>
+#include <tessellation.h>
+
+namespace polyline::detail {
+
+const char* const kPolylineVertexShader = R"(
+    #version 330 core
+    layout (location = 0) in vec3 aP0; // início do segmento (por instância)
+    layout (location = 1) in vec3 aP1; // fim do segmento (por instância)
+    uniform vec2 uViewport;            // em pixels
+    uniform float uHalfWidth;          // em pixels
+    flat out vec2 segA;
+    flat out vec2 segB;
+    void main() {
+        vec2 a = (aP0.xy * 0.5 + 0.5) * uViewport;
+        vec2 b = (aP1.xy * 0.5 + 0.5) * uViewport;
+        vec2 dir = b - a;
+        float len = length(dir);
+        dir = len > 0.0 ? dir / len : vec2(1.0, 0.0);
+        vec2 normal = vec2(-dir.y, dir.x);
+        float r = uHalfWidth + 1.0;
+
+        //Vértices 0..3: (a, -), (a, +), (b, -), (b, +)
+        float along = gl_VertexID >= 2 ? 1.0 : 0.0;
+        float side = (gl_VertexID % 2 == 0) ? -1.0 : 1.0;
+        vec2 p = mix(a, b, along) + dir * (2.0 * along - 1.0) * r + normal * side * r;
+
+        segA = a;
+        segB = b;
+        gl_Position = vec4(p / uViewport * 2.0 - 1.0, 0.0, 1.0);
+    }
+)";
+
+const char* const kPolylineFragmentShader = R"(
+    #version 330 core
+    flat in vec2 segA;
+    flat in vec2 segB;
+    uniform float uHalfWidth;
+    uniform vec4 uColor;
+    uniform int uPass; // 0: uma passada só; 1: cobertura no alfa; 2: cor
+    out vec4 FragColor;
+    void main() {
+        vec2 ab = segB - segA;
+        vec2 ap = gl_FragCoord.xy - segA;
+        float t = clamp(dot(ap, ab) / max(dot(ab, ab), 1e-6), 0.0, 1.0);
+        float d = length(ap - t * ab);
+        float coverage = clamp(uHalfWidth + 0.5 - d, 0.0, 1.0);
+        if (coverage <= 0.0) discard;
+        if (uPass == 1)
+            FragColor = vec4(0.0, 0.0, 0.0, 1.0 - uColor.a * coverage);
+        else if (uPass == 2)
+            FragColor = vec4(uColor.rgb, 1.0);
+        else
+            FragColor = vec4(uColor.rgb, uColor.a * coverage);
+    }
+)";
+
+} // namespace polyline::detail
+
+struct PolylineRenderer {
+    GLuint program = 0;
+    GLint viewportLoc = -1, halfWidthLoc = -1, colorLoc = -1, passLoc = -1;
+    bool destinationAlpha = false;  // framebuffer com alfa: desenho em duas passadas
+};
+
+inline PolylineRenderer createPolylineRenderer() {
+    PolylineRenderer renderer;
+    renderer.program = getCachedProgram(polyline::detail::kPolylineVertexShader, polyline::detail::kPolylineFragmentShader);
+    renderer.viewportLoc  = glGetUniformLocation(renderer.program, "uViewport");
+    renderer.halfWidthLoc = glGetUniformLocation(renderer.program, "uHalfWidth");
+    renderer.colorLoc     = glGetUniformLocation(renderer.program, "uColor");
+    renderer.passLoc      = glGetUniformLocation(renderer.program, "uPass");
+
+    GLint alphaBits = 0;
+    glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, GL_BACK_LEFT,
+                                          GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE, &alphaBits);
+    renderer.destinationAlpha = alphaBits > 0;
+    return renderer;
+}
+
+inline void deletePolylineRenderer(PolylineRenderer& renderer) {
+    //O programa é do cache de shaders
+    renderer = PolylineRenderer();
+}
+
+// VAO que lê os segmentos de um VBO existente (x, y, z por ponto, com stride
+// bytes entre pontos). O VBO continua sendo de quem o criou.
+struct Polyline {
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLsizei stride = 3 * sizeof(float);
+    GLint firstPoint = 0;
+    GLsizei pointCount = 0;
+};
+
+// Aponta os atributos para os pontos [firstPoint, firstPoint + pointCount) do VBO
+inline void setPolylineRange(Polyline& polyline, GLint firstPoint, GLsizei pointCount) {
+    polyline.pointCount = pointCount;
+    if (polyline.VAO == 0 || firstPoint == polyline.firstPoint) return;
+    polyline.firstPoint = firstPoint;
+
+    std::size_t offset = static_cast<std::size_t>(firstPoint) * polyline.stride;
+    glstate::bindVertexArray(polyline.VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, polyline.VBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, polyline.stride, (void*)offset);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, polyline.stride, (void*)(offset + polyline.stride));
+}
+
+inline Polyline createPolyline(GLuint VBO, GLsizei pointCount, GLsizei stride = 3 * sizeof(float)) {
+    Polyline polyline;
+    polyline.VBO = VBO;
+    polyline.stride = stride;
+    polyline.pointCount = pointCount;
+
+    glGenVertexArrays(1, &polyline.VAO);
+    glstate::bindVertexArray(polyline.VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, VBO);
+    //Ponto i e ponto i + 1, avançando uma vez por instância (segmento)
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(std::size_t)stride);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glstate::bindVertexArray(0);
+    return polyline;
+}
+
+inline void deletePolyline(Polyline& polyline) {
+    glstate::onDeleteVertexArray(polyline.VAO);
+    glDeleteVertexArrays(1, &polyline.VAO);
+    polyline = Polyline();
+}
+
+// Desenha a polilinha com widthPx pixels de largura: uma instância por segmento
+// (em cada passada)
+inline void drawPolyline(const PolylineRenderer& renderer, const Polyline& polyline, float widthPx,
+                         float r, float g, float b, float a = 1.0f) {
+    if (polyline.pointCount < 2) return;
+    glstate::useProgram(renderer.program);
+    glstate::setBlend(true);
+    glUniform2f(renderer.viewportLoc, static_cast<float>(tessellation::framebufferWidth()),
+                static_cast<float>(tessellation::framebufferHeight()));
+    glUniform1f(renderer.halfWidthLoc, 0.5f * widthPx);
+    glUniform4f(renderer.colorLoc, r, g, b, a);
+    glstate::bindVertexArray(polyline.VAO);
+    GLsizei segments = polyline.pointCount - 1;
+
+    if (!renderer.destinationAlpha) {
+        glUniform1i(renderer.passLoc, 0);
+        glstate::blendEquation(GL_FUNC_ADD);
+        glstate::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, segments);
+        return;
+    }
+
+    //1. Alfa do destino = 1 - cobertura máxima entre as cápsulas que cobrem o pixel
+    glUniform1i(renderer.passLoc, 1);
+    glstate::colorMask(false, false, false, true);
+    glstate::blendEquation(GL_MIN);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, segments);
+
+    //2. Cor composta uma vez por pixel; o alfa volta a 1
+    glUniform1i(renderer.passLoc, 2);
+    glstate::colorMask(true, true, true, true);
+    glstate::blendEquation(GL_FUNC_ADD);
+    glstate::blendFuncSeparate(GL_ONE_MINUS_DST_ALPHA, GL_DST_ALPHA, GL_ONE, GL_ZERO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, segments);
+}
+
+#endif // POLYLINE_H
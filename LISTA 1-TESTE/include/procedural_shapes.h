@@ -0,0 +1,142 @@
+#ifndef PROCEDURAL_SHAPES_H
+#define PROCEDURAL_SHAPES_H
+
+// Formas geradas inteiramente no vertex shader, sem VBO.
+//
+// Cada vértice é calculado a partir de gl_VertexID e de alguns uniforms, com a
+// mesma numeração dos geradores de shapes.h:
+//   leque (polígono, arco, estrela): vértice 0 = centro; vértice i + 1 = contorno
+//       no ângulo angleStart + sweep * i / divisions, raio alternando entre
+//       radius (i par) e innerRadius (i ímpar)
+//   espiral: vértice i no ângulo angleStart + sweep * t e raio radius * t,
+//       com t = i / divisions
+// Mudar raio, número de lados ou de voltas é só trocar uniforms: nada é
+// tesselado nem enviado pela CPU. O core profile exige um VAO ligado, então
+// usamos um VAO vazio.
+
+#include <glad/glad.h>
+
+#include <gl_state.h>
+#include <shader_cache.h>
+#include <shapes.h>
+
+namespace proceduralshapes::detail {
+
+const char* const kProceduralVertexShader = R"(
+    #version 330 core
+    uniform int uSpiral;
+    uniform vec2 uCenter;
+    uniform float uRadius;
+    uniform float uInnerRadius;
+    uniform float uAngleStart;
+    uniform float uSweep;
+    uniform int uDivisions;
+    void main() {
+        vec2 pos = uCenter;
+        if (uSpiral != 0) {
+            float t = float(gl_VertexID) / float(uDivisions);
+            float angle = uAngleStart + uSweep * t;
+            pos += uRadius * t * vec2(cos(angle), sin(angle));
+        } else if (gl_VertexID > 0) {
+            int i = gl_VertexID - 1;
+            float angle = uAngleStart + uSweep * float(i) / float(uDivisions);
+            float r = (i % 2 == 0) ? uRadius : uInnerRadius;
+            pos += r * vec2(cos(angle), sin(angle));
+        }
+        gl_Position = vec4(pos, 0.0, 1.0);
+    }
+)";
+
+const char* const kProceduralFragmentShader = R"(
+    #version 330 core
+    uniform vec4 uColor;
+    out vec4 FragColor;
+    void main() {
+        FragColor = uColor;
+    }
+)";
+
+} // namespace proceduralshapes::detail
+
+struct ProceduralShapeRenderer {
+    GLuint program = 0;
+    GLuint emptyVAO = 0;
+    GLint spiralLoc = -1, centerLoc = -1, radiusLoc = -1, innerRadiusLoc = -1;
+    GLint angleStartLoc = -1, sweepLoc = -1, divisionsLoc = -1, colorLoc = -1;
+};
+
+inline ProceduralShapeRenderer createProceduralShapeRenderer() {
+    ProceduralShapeRenderer renderer;
+
+    renderer.program = getCachedProgram(proceduralshapes::detail::kProceduralVertexShader, proceduralshapes::detail::kProceduralFragmentShader);
+
+    renderer.spiralLoc      = glGetUniformLocation(renderer.program, "uSpiral");
+    renderer.centerLoc      = glGetUniformLocation(renderer.program, "uCenter");
+    renderer.radiusLoc      = glGetUniformLocation(renderer.program, "uRadius");
+    renderer.innerRadiusLoc = glGetUniformLocation(renderer.program, "uInnerRadius");
+    renderer.angleStartLoc  = glGetUniformLocation(renderer.program, "uAngleStart");
+    renderer.sweepLoc       = glGetUniformLocation(renderer.program, "uSweep");
+    renderer.divisionsLoc   = glGetUniformLocation(renderer.program, "uDivisions");
+    renderer.colorLoc       = glGetUniformLocation(renderer.program, "uColor");
+
+    glGenVertexArrays(1, &renderer.emptyVAO);
+    return renderer;
+}
+
+inline void deleteProceduralShapeRenderer(ProceduralShapeRenderer& renderer) {
+    //O programa é do cache de shaders
+    glstate::onDeleteVertexArray(renderer.emptyVAO);
+    glDeleteVertexArrays(1, &renderer.emptyVAO);
+    renderer = ProceduralShapeRenderer();
+}
+
+// Liga programa e VAO vazio e define a cor das próximas formas
+inline void beginProceduralShapes(const ProceduralShapeRenderer& renderer, float r, float g, float b, float a = 1.0f) {
+    glstate::useProgram(renderer.program);
+    glstate::bindVertexArray(renderer.emptyVAO);
+    glUniform4f(renderer.colorLoc, r, g, b, a);
+}
+
+namespace proceduralshapes::detail {
+
+inline void drawProceduralFan(const ProceduralShapeRenderer& renderer, int divisions, float angleStart, float sweep,
+                              float radius, float innerRadius, float cx, float cy) {
+    glUniform1i(renderer.spiralLoc, 0);
+    glUniform2f(renderer.centerLoc, cx, cy);
+    glUniform1f(renderer.radiusLoc, radius);
+    glUniform1f(renderer.innerRadiusLoc, innerRadius);
+    glUniform1f(renderer.angleStartLoc, angleStart);
+    glUniform1f(renderer.sweepLoc, sweep);
+    glUniform1i(renderer.divisionsLoc, divisions);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, divisions + 2);
+}
+
+} // namespace proceduralshapes::detail
+
+inline void drawProceduralPolygon(const ProceduralShapeRenderer& renderer, int sides, float radius, float cx, float cy) {
+    proceduralshapes::detail::drawProceduralFan(renderer, sides, 0.0f, 2.0f * PI, radius, radius, cx, cy);
+}
+
+// Segmentos escolhidos pelo erro em tela, como em writeArc
+inline void drawProceduralArc(const ProceduralShapeRenderer& renderer, float angleStart, float angleEnd, float radius, float cx, float cy) {
+    proceduralshapes::detail::drawProceduralFan(renderer, arcSegments(angleStart, angleEnd, radius), angleStart, angleEnd - angleStart,
+                              radius, radius, cx, cy);
+}
+
+inline void drawProceduralStar(const ProceduralShapeRenderer& renderer, int points, float innerR, float outerR, float cx, float cy) {
+    proceduralshapes::detail::drawProceduralFan(renderer, points * 2, 0.0f, 2.0f * PI, outerR, innerR, cx, cy);
+}
+
+inline void drawProceduralSpiral(const ProceduralShapeRenderer& renderer, int numTurns, int segmentsPerTurn, float maxRadius,
+                                 float cx, float cy) {
+    int totalSegments = numTurns * segmentsPerTurn;
+    glUniform1i(renderer.spiralLoc, 1);
+    glUniform2f(renderer.centerLoc, cx, cy);
+    glUniform1f(renderer.radiusLoc, maxRadius);
+    glUniform1f(renderer.angleStartLoc, 0.0f);
+    glUniform1f(renderer.sweepLoc, 2.0f * PI * numTurns);
+    glUniform1i(renderer.divisionsLoc, totalSegments);
+    glDrawArrays(GL_LINE_STRIP, 0, totalSegments + 1);
+}
+
+#endif // PROCEDURAL_SHAPES_H
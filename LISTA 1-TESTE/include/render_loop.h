@@ -0,0 +1,147 @@
+#ifndef RENDER_LOOP_H
+#define RENDER_LOOP_H
+
+// Loop de renderização contínuo ou sob demanda.
+//
+// Por padrão os exercícios limpam e redesenham a cena a cada volta de um loop
+// com glfwPollEvents, mesmo quando nada mudou. Com --on-demand o loop dorme
+// em glfwWaitEvents e só redesenha quando há algo novo:
+//   - redimensionamento ou exposição da janela (callbacks de framebuffer e refresh);
+//   - entrada (teclado, botões do mouse, scroll);
+//   - um timer de animação (scheduleRedraw) ou um pedido explícito (requestRedraw,
+//     ou postRedraw vindo de outra thread).
+// Parado, o processo fica bloqueado no sistema de janelas: CPU e GPU perto de zero.
+//
+// Uso:
+//   setupRenderLoop(window, argc, argv);   //depois de registrar os callbacks do exercício
+//   while (nextFrame(window)) {
+//       ...desenha...
+//       glfwSwapBuffers(window);
+//   }
+// Os callbacks instalados aqui chamam os que já estavam registrados.
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace renderloop::detail {
+
+struct RenderLoopState {
+    bool onDemand = false;
+    bool dirty = true;      // o primeiro quadro sempre é desenhado
+    double deadline = -1.0; // próximo redesenho agendado (glfwGetTime), < 0 se nenhum
+    std::atomic<bool> posted{false}; // pedido de outra thread (postRedraw)
+    GLFWframebuffersizefun previousFramebufferSize = nullptr;
+    GLFWwindowrefreshfun previousRefresh = nullptr;
+    GLFWkeyfun previousKey = nullptr;
+    GLFWmousebuttonfun previousMouseButton = nullptr;
+    GLFWscrollfun previousScroll = nullptr;
+};
+
+inline RenderLoopState& renderLoopState() {
+    static RenderLoopState state;
+    return state;
+}
+
+inline void onFramebufferSizeRedraw(GLFWwindow* window, int width, int height) {
+    RenderLoopState& state = renderLoopState();
+    if (state.previousFramebufferSize) state.previousFramebufferSize(window, width, height);
+    state.dirty = true;
+}
+
+inline void onRefreshRedraw(GLFWwindow* window) {
+    RenderLoopState& state = renderLoopState();
+    if (state.previousRefresh) state.previousRefresh(window);
+    state.dirty = true;
+}
+
+inline void onKeyRedraw(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    RenderLoopState& state = renderLoopState();
+    if (state.previousKey) state.previousKey(window, key, scancode, action, mods);
+    state.dirty = true;
+}
+
+inline void onMouseButtonRedraw(GLFWwindow* window, int button, int action, int mods) {
+    RenderLoopState& state = renderLoopState();
+    if (state.previousMouseButton) state.previousMouseButton(window, button, action, mods);
+    state.dirty = true;
+}
+
+inline void onScrollRedraw(GLFWwindow* window, double xOffset, double yOffset) {
+    RenderLoopState& state = renderLoopState();
+    if (state.previousScroll) state.previousScroll(window, xOffset, yOffset);
+    state.dirty = true;
+}
+
+} // namespace renderloop::detail
+
+// Pede um redesenho na próxima volta do loop
+inline void requestRedraw() {
+    renderloop::detail::renderLoopState().dirty = true;
+}
+
+// Pede um redesenho daqui a delaySeconds (animações); 0 = assim que possível.
+// Vale o mais cedo entre os pedidos pendentes.
+inline void scheduleRedraw(double delaySeconds) {
+    renderloop::detail::RenderLoopState& state = renderloop::detail::renderLoopState();
+    double when = glfwGetTime() + std::max(0.0, delaySeconds);
+    state.deadline = state.deadline < 0.0 ? when : std::min(state.deadline, when);
+}
+
+// Pede um redesenho a partir de outra thread: acorda o glfwWaitEvents
+inline void postRedraw() {
+    renderloop::detail::renderLoopState().posted = true;
+    glfwPostEmptyEvent();
+}
+
+inline bool renderOnDemand() {
+    return renderloop::detail::renderLoopState().onDemand;
+}
+
+// Lê --on-demand e, nesse modo, instala os callbacks que marcam a cena como suja
+inline void setupRenderLoop(GLFWwindow* window, int argc, char** argv) {
+    renderloop::detail::RenderLoopState& state = renderloop::detail::renderLoopState();
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--on-demand") == 0) state.onDemand = true;
+    }
+    if (!state.onDemand) return;
+
+    state.previousFramebufferSize = glfwSetFramebufferSizeCallback(window, renderloop::detail::onFramebufferSizeRedraw);
+    state.previousRefresh = glfwSetWindowRefreshCallback(window, renderloop::detail::onRefreshRedraw);
+    state.previousKey = glfwSetKeyCallback(window, renderloop::detail::onKeyRedraw);
+    state.previousMouseButton = glfwSetMouseButtonCallback(window, renderloop::detail::onMouseButtonRedraw);
+    state.previousScroll = glfwSetScrollCallback(window, renderloop::detail::onScrollRedraw);
+}
+
+// Processa eventos e retorna quando há um quadro para desenhar (true) ou a
+// janela vai fechar (false). No modo contínuo equivale a glfwPollEvents.
+inline bool nextFrame(GLFWwindow* window) {
+    renderloop::detail::RenderLoopState& state = renderloop::detail::renderLoopState();
+    if (!state.onDemand) {
+        glfwPollEvents();
+        return !glfwWindowShouldClose(window);
+    }
+
+    glfwPollEvents();
+    while (!glfwWindowShouldClose(window)) {
+        double now = glfwGetTime();
+        if (state.posted.exchange(false)) state.dirty = true;
+        if (state.deadline >= 0.0 && now >= state.deadline) {
+            state.deadline = -1.0;
+            state.dirty = true;
+        }
+        if (state.dirty) {
+            state.dirty = false;
+            return true;
+        }
+        if (state.deadline >= 0.0)
+            glfwWaitEventsTimeout(state.deadline - now);
+        else
+            glfwWaitEvents();
+    }
+    return false;
+}
+
+#endif // RENDER_LOOP_H
@@ -0,0 +1,449 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+// Cache de shader programs por conteúdo.
+//
+// getCachedProgram(vertex, fragment, defines) procura o programa pelo hash
+// (FNV-1a de 64 bits) do código dos estágios e dos #defines injetados. Se já
+// existe, devolve o mesmo handle sem compilar nada; senão compila, liga e
+// guarda. Os estágios também são cacheados um a um: um vertex shader comum a
+// vários programas é compilado uma vez só.
+//
+// O hash é calculado sobre o código normalizado (sem espaços no começo e no
+// fim das linhas e sem linhas vazias), então o mesmo shader escrito com outra
+// indentação em outro arquivo cai na mesma entrada. A entrada guarda o texto
+// normalizado e confere na busca, para que uma colisão de hash nunca troque
+// um programa por outro.
+//
+// Com enableProgramBinaryCache(diretório), os programas ligados também vão
+// para o disco (glGetProgramBinary, GL_ARB_get_program_binary). A chave do
+// arquivo é o hash do programa mais o hash de vendor/renderer/versão do
+// driver; o arquivo guarda ainda o texto dos estágios e a string do driver,
+// conferidos na leitura. Numa partida seguinte o programa sai de
+// glProgramBinary sem compilar nenhum estágio. Se o arquivo estiver truncado
+// ou corrompido, ou se o driver recusar o binário (atualização do driver, por
+// exemplo), o arquivo é apagado e o programa é compilado e salvo de novo. A
+// gravação passa por um arquivo temporário renomeado no fim, então dois
+// programas usando o mesmo diretório nunca leem um arquivo pela metade.
+//
+// Os programas são do cache: quem recebe o handle não chama glDeleteProgram.
+// Cada getCachedProgram conta uma referência; releaseCachedProgram devolve
+// uma, e a última apaga o programa e os estágios que só ele usava (e, com
+// removeBinary, o binário em disco, para versões substituídas que não voltam).
+// Programas que não ligaram não ficam no cache: o mesmo código é recompilado
+// no próximo pedido. clearShaderCache() apaga tudo e deve ser chamado antes
+// de destruir o contexto. O cache é thread_local, como o contexto corrente.
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gl_state.h>
+#include <shader_utils.h>
+
+struct ShaderCacheStats {
+    unsigned programHits = 0;    // programas devolvidos do cache
+    unsigned programsLinked = 0;
+    unsigned stageHits = 0;      // estágios reaproveitados ao ligar um programa novo
+    unsigned stagesCompiled = 0;
+    unsigned binariesLoaded = 0;   // programas lidos do disco, sem compilar
+    unsigned binariesSaved = 0;
+    unsigned binariesRejected = 0; // recusados pelo driver e recompilados
+};
+
+namespace shadercache::detail {
+
+const std::uint64_t kFnvOffset = 14695981039346656037ull;
+const std::uint64_t kFnvPrime = 1099511628211ull;
+
+inline std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t hash = kFnvOffset) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// Insere o bloco de #defines logo depois da linha #version (ou no início, se não houver)
+inline std::string injectDefines(const char* source, const char* defines) {
+    std::string result(source);
+    if (!defines || !*defines) return result;
+
+    std::string block(defines);
+    if (block.back() != '\n') block += '\n';
+
+    std::size_t at = 0;
+    std::size_t version = result.find("#version");
+    if (version != std::string::npos) {
+        std::size_t lineEnd = result.find('\n', version);
+        at = lineEnd == std::string::npos ? result.size() : lineEnd + 1;
+        if (lineEnd == std::string::npos) block.insert(block.begin(), '\n');
+    }
+    result.insert(at, block);
+    return result;
+}
+
+// Tira espaços do começo e do fim de cada linha e descarta linhas vazias
+inline std::string normalizeShaderSource(const std::string& source) {
+    std::string result;
+    result.reserve(source.size());
+    std::size_t start = 0;
+    while (start < source.size()) {
+        std::size_t end = source.find('\n', start);
+        if (end == std::string::npos) end = source.size();
+        std::size_t first = start, last = end;
+        while (first < last && std::strchr(" \t\r\f\v", source[first])) first++;
+        while (last > first && std::strchr(" \t\r\f\v", source[last - 1])) last--;
+        if (last > first) {
+            result.append(source, first, last - first);
+            result += '\n';
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+struct CachedStage {
+    GLenum type = 0;
+    std::string source;  // normalizado, para conferir colisões
+    GLuint shader = 0;
+};
+
+struct CachedProgram {
+    std::uint64_t vertexHash = 0, fragmentHash = 0;
+    GLuint program = 0;
+    unsigned refs = 0;  // getCachedProgram menos releaseCachedProgram
+};
+
+struct ProgramBinaryStore {
+    std::filesystem::path directory;  // vazio: desligado
+    std::string driver;               // vendor, renderer e versão
+    std::uint64_t driverHash = 0;
+};
+
+struct ShaderCache {
+    std::unordered_map<std::uint64_t, CachedStage> stages;
+    std::unordered_map<std::uint64_t, CachedProgram> programs;
+    std::vector<GLuint> uncached;  // colisões de hash e links com erro: fora do cache, apagados no clear
+    ProgramBinaryStore binaries;
+    ShaderCacheStats stats;
+};
+
+inline ShaderCache& shaderCache() {
+    thread_local ShaderCache cache;
+    return cache;
+}
+
+inline std::uint64_t stageHash(GLenum type, const std::string& normalized) {
+    std::uint64_t hash = fnv1a(&type, sizeof(type));
+    return fnv1a(normalized.data(), normalized.size(), hash);
+}
+
+// Estágio já compilado; nullptr se não existe ou se o hash colide com outro texto
+inline const CachedStage* findStage(std::uint64_t hash, GLenum type, const std::string& normalized, bool& collision) {
+    ShaderCache& cache = shaderCache();
+    auto found = cache.stages.find(hash);
+    if (found == cache.stages.end()) return nullptr;
+    collision = found->second.type != type || found->second.source != normalized;
+    return collision ? nullptr : &found->second;
+}
+
+// Estágio do cache ou compilado agora (o chamador já descartou colisões)
+inline const CachedStage* compileStage(std::uint64_t hash, GLenum type, std::string normalized,
+                                       const std::string& source) {
+    ShaderCache& cache = shaderCache();
+    bool collision = false;
+    if (const CachedStage* stage = findStage(hash, type, normalized, collision)) {
+        cache.stats.stageHits++;
+        return stage;
+    }
+    CachedStage& stage = cache.stages[hash];
+    stage.type = type;
+    stage.source = std::move(normalized);
+    stage.shader = compileShaderStage(type, source.c_str());
+    cache.stats.stagesCompiled++;
+    return &stage;
+}
+
+//==== Binários em disco ====
+
+const char kProgramBinaryMagic[4] = {'P', 'B', 'I', 'N'};
+
+inline std::filesystem::path programBinaryPath(const ProgramBinaryStore& store, std::uint64_t programHash) {
+    std::uint64_t key = fnv1a(&store.driverHash, sizeof(store.driverHash), programHash);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return store.directory / name;
+}
+
+inline void writeBlock(std::ofstream& file, const void* data, std::uint32_t size) {
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(static_cast<const char*>(data), size);
+}
+
+// Bloco com o tamanho na frente. fileSize limita o tamanho: um arquivo
+// corrompido não pode pedir mais memória do que os bytes que ainda restam nele.
+inline bool readBlock(std::ifstream& file, std::uint64_t fileSize, std::string& out) {
+    std::uint32_t size = 0;
+    if (!file.read(reinterpret_cast<char*>(&size), sizeof(size))) return false;
+    std::streamoff position = file.tellg();
+    if (position < 0 || size > fileSize - static_cast<std::uint64_t>(position)) return false;
+    out.resize(size);
+    return size == 0 || static_cast<bool>(file.read(&out[0], size));
+}
+
+// Arquivo: magic, string do driver, texto dos dois estágios, formato e binário
+inline void saveProgramBinary(ShaderCache& cache, std::uint64_t programHash, GLuint program,
+                              const std::string& vertexText, const std::string& fragmentText) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    //Escreve num temporário e renomeia: outro programa lendo o mesmo diretório
+    //vê o arquivo antigo ou o novo inteiro, nunca um pela metade
+    std::filesystem::path path = programBinaryPath(cache.binaries, programHash);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp" + std::to_string(std::random_device()());  //único entre processos e threads
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file.write(kProgramBinaryMagic, sizeof(kProgramBinaryMagic));
+        writeBlock(file, cache.binaries.driver.data(), static_cast<std::uint32_t>(cache.binaries.driver.size()));
+        writeBlock(file, vertexText.data(), static_cast<std::uint32_t>(vertexText.size()));
+        writeBlock(file, fragmentText.data(), static_cast<std::uint32_t>(fragmentText.size()));
+        file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        writeBlock(file, binary.data(), static_cast<std::uint32_t>(length));
+        file.close();
+        if (!file) {
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+    cache.stats.binariesSaved++;
+}
+
+// Programa a partir do binário em disco; 0 se não há arquivo válido
+inline GLuint loadProgramBinary(ShaderCache& cache, std::uint64_t programHash,
+                                const std::string& vertexText, const std::string& fragmentText) {
+    std::filesystem::path path = programBinaryPath(cache.binaries, programHash);
+    std::error_code sizeError;
+    std::uint64_t fileSize = std::filesystem::file_size(path, sizeError);
+    std::ifstream file(path, std::ios::binary);
+    if (sizeError || !file) return 0;
+
+    char magic[sizeof(kProgramBinaryMagic)];
+    std::string driver, vertex, fragment, binary;
+    GLenum format = 0;
+    bool valid = file.read(magic, sizeof(magic)) && std::memcmp(magic, kProgramBinaryMagic, sizeof(magic)) == 0 &&
+                 readBlock(file, fileSize, driver) && readBlock(file, fileSize, vertex) &&
+                 readBlock(file, fileSize, fragment) &&
+                 file.read(reinterpret_cast<char*>(&format), sizeof(format)) && readBlock(file, fileSize, binary);
+    if (!valid) {
+        //Truncado ou corrompido: apaga, e o programa é compilado e salvo de novo
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        cache.stats.binariesRejected++;
+        return 0;
+    }
+    //Outro driver ou colisão de hash: o arquivo será sobrescrito pela versão compilada
+    if (driver != cache.binaries.driver || vertex != vertexText || fragment != fragmentText)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        cache.stats.binariesRejected++;
+        return 0;
+    }
+    cache.stats.binariesLoaded++;
+    return program;
+}
+
+} // namespace shadercache::detail
+
+// Liga o cache em disco no diretório dado (criado se preciso). Retorna false
+// se o driver não oferece binários de programa; o cache em memória continua.
+inline bool enableProgramBinaryCache(const char* directory) {
+    shadercache::detail::ProgramBinaryStore& store = shadercache::detail::shaderCache().binaries;
+    store = shadercache::detail::ProgramBinaryStore();
+
+    GLint formats = 0;
+    if (GLAD_GL_ARB_get_program_binary) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        std::cerr << "Driver sem suporte a binarios de programa: cache em disco desligado" << std::endl;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Nao foi possivel criar o diretorio do cache de shaders: " << directory << std::endl;
+        return false;
+    }
+
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const GLubyte* value = glGetString(name);
+        store.driver += value ? reinterpret_cast<const char*>(value) : "";
+        store.driver += '\n';
+    }
+    store.driverHash = shadercache::detail::fnv1a(store.driver.data(), store.driver.size());
+    store.directory = directory;
+    return true;
+}
+
+// Programa com os estágios dados; defines (linhas "#define NOME valor") entra
+// depois do #version dos dois estágios e faz parte da chave
+inline GLuint getCachedProgram(const char* vShaderSrc, const char* fShaderSrc, const char* defines = "") {
+    shadercache::detail::ShaderCache& cache = shadercache::detail::shaderCache();
+    std::string vertexSource = shadercache::detail::injectDefines(vShaderSrc, defines);
+    std::string fragmentSource = shadercache::detail::injectDefines(fShaderSrc, defines);
+    std::string vertexText = shadercache::detail::normalizeShaderSource(vertexSource);
+    std::string fragmentText = shadercache::detail::normalizeShaderSource(fragmentSource);
+    std::uint64_t vertexHash = shadercache::detail::stageHash(GL_VERTEX_SHADER, vertexText);
+    std::uint64_t fragmentHash = shadercache::detail::stageHash(GL_FRAGMENT_SHADER, fragmentText);
+
+    bool collision = false;
+    shadercache::detail::findStage(vertexHash, GL_VERTEX_SHADER, vertexText, collision);
+    shadercache::detail::findStage(fragmentHash, GL_FRAGMENT_SHADER, fragmentText, collision);
+    if (collision) {
+        GLuint program = buildShaderProgram(vertexSource.c_str(), fragmentSource.c_str());
+        cache.uncached.push_back(program);
+        return program;
+    }
+
+    std::uint64_t hash = shadercache::detail::fnv1a(&vertexHash, sizeof(vertexHash));
+    hash = shadercache::detail::fnv1a(&fragmentHash, sizeof(fragmentHash), hash);
+    auto found = cache.programs.find(hash);
+    if (found != cache.programs.end() && found->second.vertexHash == vertexHash &&
+        found->second.fragmentHash == fragmentHash) {
+        cache.stats.programHits++;
+        found->second.refs++;
+        return found->second.program;
+    }
+    bool programCollision = found != cache.programs.end();
+    bool onDisk = !cache.binaries.directory.empty() && !programCollision;
+
+    GLuint program = onDisk ? shadercache::detail::loadProgramBinary(cache, hash, vertexText, fragmentText) : 0;
+    bool linked = program != 0;
+    if (program == 0) {
+        const shadercache::detail::CachedStage* vertex = shadercache::detail::compileStage(vertexHash, GL_VERTEX_SHADER, vertexText, vertexSource);
+        const shadercache::detail::CachedStage* fragment = shadercache::detail::compileStage(fragmentHash, GL_FRAGMENT_SHADER, fragmentText, fragmentSource);
+        program = linkShaderProgram(vertex->shader, fragment->shader, onDisk);
+        cache.stats.programsLinked++;
+
+        GLint success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        linked = success != 0;
+        if (onDisk && linked) shadercache::detail::saveProgramBinary(cache, hash, program, vertexText, fragmentText);
+    }
+
+    //Com erro, fica fora do cache para que o mesmo código seja tentado de novo
+    if (programCollision || !linked) {
+        cache.uncached.push_back(program);
+        return program;
+    }
+    cache.programs[hash] = shadercache::detail::CachedProgram{vertexHash, fragmentHash, program, 1};
+    return program;
+}
+
+namespace shadercache::detail {
+
+// Apaga os estágios que nenhum programa do cache usa (sobras de versões
+// substituídas e de tentativas com erro)
+inline void pruneUnusedStages(ShaderCache& cache) {
+    for (auto stage = cache.stages.begin(); stage != cache.stages.end();) {
+        bool used = false;
+        for (const auto& entry : cache.programs)
+            used = used || entry.second.vertexHash == stage->first || entry.second.fragmentHash == stage->first;
+        if (used) {
+            ++stage;
+            continue;
+        }
+        glDeleteShader(stage->second.shader);
+        stage = cache.stages.erase(stage);
+    }
+}
+
+} // namespace shadercache::detail
+
+// Devolve uma referência de um programa de getCachedProgram. Na última, apaga o
+// programa e os estágios que mais nenhum programa usa; com removeBinary, também
+// o binário em disco.
+inline void releaseCachedProgram(GLuint program, bool removeBinary = false) {
+    shadercache::detail::ShaderCache& cache = shadercache::detail::shaderCache();
+    for (auto it = cache.uncached.begin(); it != cache.uncached.end(); ++it) {
+        if (*it != program) continue;
+        cache.uncached.erase(it);
+        glstate::onDeleteProgram(program);
+        glDeleteProgram(program);
+        shadercache::detail::pruneUnusedStages(cache);
+        return;
+    }
+
+    auto found = cache.programs.begin();
+    while (found != cache.programs.end() && found->second.program != program) ++found;
+    if (found == cache.programs.end() || --found->second.refs > 0) return;
+
+    std::uint64_t hash = found->first;
+    cache.programs.erase(found);
+    glstate::onDeleteProgram(program);
+    glDeleteProgram(program);
+    shadercache::detail::pruneUnusedStages(cache);
+
+    if (removeBinary && !cache.binaries.directory.empty()) {
+        std::error_code error;
+        std::filesystem::remove(shadercache::detail::programBinaryPath(cache.binaries, hash), error);
+    }
+}
+
+// Apaga todos os programas e estágios do contexto corrente (o cache em disco fica)
+inline void clearShaderCache() {
+    shadercache::detail::ShaderCache& cache = shadercache::detail::shaderCache();
+    for (auto& entry : cache.programs) {
+        glstate::onDeleteProgram(entry.second.program);
+        glDeleteProgram(entry.second.program);
+    }
+    for (GLuint program : cache.uncached) {
+        glstate::onDeleteProgram(program);
+        glDeleteProgram(program);
+    }
+    for (auto& entry : cache.stages)
+        glDeleteShader(entry.second.shader);
+    shadercache::detail::ShaderCache cleared;
+    cleared.binaries = cache.binaries;
+    cleared.stats = cache.stats;
+    cache = std::move(cleared);
+}
+
+inline ShaderCacheStats shaderCacheStats() {
+    return shadercache::detail::shaderCache().stats;
+}
+
+#endif // SHADER_CACHE_H
@@ -0,0 +1,318 @@
+#ifndef SHADER_MANAGER_H
+#define SHADER_MANAGER_H
+
+// Programas carregados de arquivos, recarregados quando os arquivos mudam.
+//
+// Uma thread de fundo observa os diretórios dos shaders (inotify no Linux;
+// nos outros sistemas, ou se o inotify não estiver disponível, a data de
+// modificação a cada 250 ms). Quando um arquivo é salvo, ela relê só os
+// programas que usam esse arquivo e deixa o código novo numa fila. A
+// compilação precisa do contexto GL, então fica para updateShaderManager,
+// chamado na thread de renderização no começo do quadro: o programa novo
+// entra no lugar do antigo entre dois quadros, e se a compilação ou o link
+// falhar o antigo continua valendo.
+//
+// Limitação: a compilação da recarga é síncrona, na thread de renderização;
+// o quadro em que um shader salvo é recompilado espera o driver. Para
+// compilar sem travar o quadro, ver async_shaders.h.
+//
+// Uso:
+//   ShaderManager shaders = createShaderManager();
+//   int program = loadShaderProgram(shaders, "../shaders/shader.vert", "../shaders/shader.frag");
+//   while (nextFrame(window)) {
+//       updateShaderManager(shaders);
+//       glstate::useProgram(shaderProgram(shaders, program));
+//       ...
+//   }
+//   deleteShaderManager(shaders);
+//
+// Os programas vêm do cache de shaders (shader_cache.h). Ao trocar, a versão
+// antiga é devolvida ao cache, que a apaga junto com o binário em disco;
+// versões com erro também são apagadas e o código é tentado de novo no
+// próximo salvamento.
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <render_loop.h>
+#include <shader_cache.h>
+
+// Carrega o código do shader de um arquivo ("" se não abrir)
+inline std::string readShaderSource(const char* path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao abrir o arquivo de shader: " << path << std::endl;
+        return "";
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+namespace shadermanager::detail {
+
+struct WatchedProgram {
+    std::filesystem::path vertexPath, fragmentPath;
+};
+
+struct PendingShaderReload {
+    int handle = -1;
+    std::string vertexSource, fragmentSource;
+};
+
+struct ShaderWatcher {
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    std::mutex mutex;  // protege watched, pending, os diretórios e as datas
+    std::vector<WatchedProgram> watched;
+    std::vector<PendingShaderReload> pending;
+#ifdef __linux__
+    int fd = -1;  // -1: sem inotify, observa pelas datas
+    std::unordered_map<int, std::filesystem::path> directories;  // watch descriptor -> diretório
+#endif
+    //Arquivos observados pela data de modificação (sem inotify, ou se o diretório não pôde ser observado)
+    std::unordered_map<std::string, std::filesystem::file_time_type> stamps;
+};
+
+inline std::filesystem::path normalizeShaderPath(const char* path) {
+    return std::filesystem::path(path).lexically_normal();
+}
+
+// Relê os programas que usam algum dos arquivos alterados e enfileira o código novo
+inline void queueShaderReloads(ShaderWatcher& watcher, const std::vector<std::filesystem::path>& changed) {
+    std::vector<WatchedProgram> watched;
+    {
+        std::lock_guard<std::mutex> lock(watcher.mutex);
+        watched = watcher.watched;
+    }
+
+    std::vector<PendingShaderReload> reloads;
+    for (int handle = 0; handle < static_cast<int>(watched.size()); handle++) {
+        const WatchedProgram& program = watched[handle];
+        bool affected = false;
+        for (const std::filesystem::path& path : changed)
+            affected = affected || path == program.vertexPath || path == program.fragmentPath;
+        if (!affected) continue;
+        reloads.push_back({handle, readShaderSource(program.vertexPath.string().c_str()),
+                           readShaderSource(program.fragmentPath.string().c_str())});
+    }
+    if (reloads.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(watcher.mutex);
+        for (PendingShaderReload& reload : reloads) {
+            //Salvamentos seguidos do mesmo programa: vale o último
+            bool replaced = false;
+            for (PendingShaderReload& pending : watcher.pending) {
+                if (pending.handle == reload.handle) {
+                    pending = std::move(reload);
+                    replaced = true;
+                    break;
+                }
+            }
+            if (!replaced) watcher.pending.push_back(std::move(reload));
+        }
+    }
+    postRedraw();
+}
+
+inline void watchShaderFileStamp(ShaderWatcher& watcher, const std::filesystem::path& file) {
+    std::error_code error;
+    auto stamp = std::filesystem::last_write_time(file, error);
+    std::lock_guard<std::mutex> lock(watcher.mutex);
+    watcher.stamps[file.string()] = error ? std::filesystem::file_time_type() : stamp;
+}
+
+// Arquivos de stamps cuja data mudou desde a última consulta
+inline std::vector<std::filesystem::path> changedShaderStamps(ShaderWatcher& watcher) {
+    std::vector<std::filesystem::path> changed;
+    std::lock_guard<std::mutex> lock(watcher.mutex);
+    for (auto& entry : watcher.stamps) {
+        std::error_code error;
+        auto stamp = std::filesystem::last_write_time(entry.first, error);
+        if (error || stamp == entry.second) continue;
+        entry.second = stamp;
+        changed.push_back(entry.first);
+    }
+    return changed;
+}
+
+inline void runPollingShaderWatcher(ShaderWatcher* watcher) {
+    while (watcher->running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        std::vector<std::filesystem::path> changed = changedShaderStamps(*watcher);
+        if (!changed.empty()) queueShaderReloads(*watcher, changed);
+    }
+}
+
+#ifdef __linux__
+
+inline bool watchInotifyDirectory(ShaderWatcher& watcher, const std::filesystem::path& file) {
+    std::filesystem::path directory = file.parent_path();
+    if (directory.empty()) directory = ".";
+
+    std::lock_guard<std::mutex> lock(watcher.mutex);
+    for (const auto& entry : watcher.directories)
+        if (entry.second == directory) return true;
+    //IN_MOVED_TO cobre editores que salvam num arquivo temporário e renomeiam
+    int wd = inotify_add_watch(watcher.fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        std::cerr << "Nao foi possivel observar o diretorio de shaders: " << directory
+                  << " (usando a data de modificacao)" << std::endl;
+        return false;
+    }
+    watcher.directories[wd] = directory;
+    return true;
+}
+
+inline void runInotifyShaderWatcher(ShaderWatcher* watcher) {
+    alignas(inotify_event) char buffer[4096];
+    while (watcher->running) {
+        pollfd request = {watcher->fd, POLLIN, 0};
+        int ready = poll(&request, 1, 200);  //acorda periodicamente para ver se deve parar
+        //Arquivos em diretórios que o inotify recusou
+        std::vector<std::filesystem::path> changed = changedShaderStamps(*watcher);
+        ssize_t length = ready > 0 ? read(watcher->fd, buffer, sizeof(buffer)) : 0;
+        if (length > 0) {
+            std::lock_guard<std::mutex> lock(watcher->mutex);
+            for (char* at = buffer; at < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                auto directory = watcher->directories.find(event->wd);
+                if (event->len > 0 && directory != watcher->directories.end())
+                    changed.push_back((directory->second / event->name).lexically_normal());
+                at += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (!changed.empty()) queueShaderReloads(*watcher, changed);
+    }
+}
+
+#endif
+
+inline void watchShaderDirectory(ShaderWatcher& watcher, const std::filesystem::path& file) {
+#ifdef __linux__
+    if (watcher.fd >= 0 && watchInotifyDirectory(watcher, file)) return;
+#endif
+    watchShaderFileStamp(watcher, file);
+}
+
+inline void runShaderWatcher(ShaderWatcher* watcher) {
+#ifdef __linux__
+    if (watcher->fd >= 0) {
+        runInotifyShaderWatcher(watcher);
+        return;
+    }
+#endif
+    runPollingShaderWatcher(watcher);
+}
+
+inline bool programLinked(GLuint program) {
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    return success != 0;
+}
+
+} // namespace shadermanager::detail
+
+struct ShaderManager {
+    std::vector<GLuint> programs;  // programa atual de cada handle
+    std::unique_ptr<shadermanager::detail::ShaderWatcher> watcher;
+};
+
+inline ShaderManager createShaderManager() {
+    ShaderManager manager;
+    manager.watcher = std::make_unique<shadermanager::detail::ShaderWatcher>();
+#ifdef __linux__
+    manager.watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (manager.watcher->fd < 0)
+        std::cerr << "inotify indisponivel: shaders serao observados pela data de modificacao" << std::endl;
+#endif
+    manager.watcher->running = true;
+    manager.watcher->thread = std::thread(shadermanager::detail::runShaderWatcher, manager.watcher.get());
+    return manager;
+}
+
+// Devolve os programas ao cache (os binários em disco ficam para a próxima partida)
+inline void deleteShaderManager(ShaderManager& manager) {
+    for (GLuint program : manager.programs)
+        releaseCachedProgram(program);
+    if (manager.watcher) {
+        manager.watcher->running = false;
+        if (manager.watcher->thread.joinable()) manager.watcher->thread.join();
+#ifdef __linux__
+        if (manager.watcher->fd >= 0) close(manager.watcher->fd);
+#endif
+    }
+    manager = ShaderManager();
+}
+
+// Compila o programa e passa a observar os dois arquivos. Retorna o handle.
+inline int loadShaderProgram(ShaderManager& manager, const char* vertexPath, const char* fragmentPath) {
+    std::string vertexCode = readShaderSource(vertexPath);
+    std::string fragmentCode = readShaderSource(fragmentPath);
+    int handle = static_cast<int>(manager.programs.size());
+    manager.programs.push_back(getCachedProgram(vertexCode.c_str(), fragmentCode.c_str()));
+
+    shadermanager::detail::WatchedProgram watched{shadermanager::detail::normalizeShaderPath(vertexPath), shadermanager::detail::normalizeShaderPath(fragmentPath)};
+    if (manager.watcher) {
+        shadermanager::detail::watchShaderDirectory(*manager.watcher, watched.vertexPath);
+        shadermanager::detail::watchShaderDirectory(*manager.watcher, watched.fragmentPath);
+        std::lock_guard<std::mutex> lock(manager.watcher->mutex);
+        manager.watcher->watched.push_back(std::move(watched));
+    }
+    return handle;
+}
+
+inline GLuint shaderProgram(const ShaderManager& manager, int handle) {
+    return manager.programs[handle];
+}
+
+// Compila as recargas pendentes e troca os programas que ligaram sem erro; a
+// versão substituída sai do cache e do disco. Chamar na thread do contexto,
+// entre quadros. Retorna quantos foram trocados.
+inline int updateShaderManager(ShaderManager& manager) {
+    if (!manager.watcher) return 0;
+    std::vector<shadermanager::detail::PendingShaderReload> pending;
+    {
+        std::lock_guard<std::mutex> lock(manager.watcher->mutex);
+        pending.swap(manager.watcher->pending);
+    }
+
+    int swapped = 0;
+    for (const shadermanager::detail::PendingShaderReload& reload : pending) {
+        GLuint program = getCachedProgram(reload.vertexSource.c_str(), reload.fragmentSource.c_str());
+        if (!shadermanager::detail::programLinked(program)) {
+            std::cerr << "Shader recarregado com erro; mantendo a versao anterior" << std::endl;
+            releaseCachedProgram(program);
+            continue;
+        }
+        //Salvo sem mudança: o mesmo programa volta, e a referência extra é devolvida
+        GLuint previous = manager.programs[reload.handle];
+        manager.programs[reload.handle] = program;
+        releaseCachedProgram(previous, previous != program);
+        swapped++;
+    }
+    if (swapped > 0) std::cout << "Shaders recarregados: " << swapped << std::endl;
+    return swapped;
+}
+
+#endif // SHADER_MANAGER_H
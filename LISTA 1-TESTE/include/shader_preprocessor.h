@@ -0,0 +1,289 @@
+#ifndef SHADER_PREPROCESSOR_H
+#define SHADER_PREPROCESSOR_H
+
+// Pré-processador de shaders: #include, conjuntos de #define e permutações
+// compiladas sob demanda.
+//
+// Os shaders são procurados por nome: primeiro na biblioteca em memória
+// (os embutidos abaixo e os registrados com registerShaderSource), depois nos
+// diretórios de addShaderIncludePath. preprocessShader(nome, defines) monta o
+// código final:
+//   - a linha #version do arquivo (ou "#version 330 core" se não houver);
+//   - um "#define NOME valor" para cada entrada de defines;
+//   - o corpo, com cada #include "outro" trocado pelo conteúdo de outro.
+//     Cada arquivo entra uma vez só por shader (como #pragma once), e
+//     #version dentro de arquivos incluídos é descartado.
+// Os #ifdef continuam para o compilador GLSL.
+//
+// Números de linha: cada arquivo recebe um número de fonte (0 para o shader
+// pedido, 1, 2, ... para os incluídos, na ordem) e o corpo leva diretivas
+// "#line linha fonte" no início de cada arquivo e na volta de cada include,
+// então os erros do compilador ("1:4: ...") apontam o arquivo e a linha
+// originais. Um comentário "// fonte N: nome" antes de cada arquivo
+// registra a correspondência no próprio código gerado.
+//
+// Os #include são expandidos antes do compilador GLSL ver os #ifdef, então
+// são incondicionais: um include dentro de um bloco #ifdef inativo é lido
+// (o arquivo precisa existir) e gasta a única inclusão daquele arquivo, mas o
+// conteúdo fica dentro do bloco e é descartado pelo compilador. Se o mesmo
+// arquivo for incluído depois num trecho ativo, essa segunda inclusão é
+// ignorada e as definições faltam. Inclua fora de blocos condicionais (como
+// color.glsl, que tem os seus próprios #ifdef por dentro).
+//
+// Permutações:
+//   ShaderPermutations basic = createShaderPermutations("basic.vert", "basic.frag");
+//   int orange = shaderVariant(basic, {{"SOLID_COLOR", "vec4(1.0, 0.6, 0.2, 1.0)"}});
+//   ...
+//   glstate::useProgram(variantProgram(basic, orange));  //compila no primeiro uso
+// shaderVariant só registra a combinação de defines; nada é compilado até um
+// desenho pedir o programa. Combinações iguais (em qualquer ordem) dão o mesmo
+// handle. Os programas vêm do cache de shaders (shader_cache.h); depois de
+// clearShaderCache() as permutações antigas não devem mais ser usadas.
+
+#include <glad/glad.h>
+
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <shader_cache.h>
+
+// Conjunto de #defines; a ordem dos nomes não importa
+struct ShaderDefines {
+    std::map<std::string, std::string> values;
+
+    ShaderDefines() = default;
+    ShaderDefines(std::initializer_list<std::pair<const std::string, std::string>> list) : values(list) {}
+
+    // Texto canônico (ordenado por nome), usado como chave da permutação
+    std::string key() const {
+        std::string result;
+        for (const auto& entry : values)
+            result += entry.first + '=' + entry.second + ';';
+        return result;
+    }
+};
+
+namespace shaderpreprocessor::detail {
+
+//==== Biblioteca embutida ====
+
+// Cor do fragmento: por vértice (VERTEX_COLOR) ou constante (SOLID_COLOR)
+const char* const kColorInclude = R"(
+#ifdef VERTEX_COLOR
+in vec3 vertexColor;
+vec4 baseColor() { return vec4(vertexColor, 1.0); }
+#else
+#ifndef SOLID_COLOR
+#define SOLID_COLOR vec4(1.0)
+#endif
+vec4 baseColor() { return SOLID_COLOR; }
+#endif
+)";
+
+const char* const kBasicVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+#ifdef VERTEX_COLOR
+layout (location = 1) in vec3 aColor;
+out vec3 vertexColor;
+#endif
+void main() {
+    gl_Position = vec4(aPos, 1.0);
+#ifdef VERTEX_COLOR
+    vertexColor = aColor;
+#endif
+}
+)";
+
+const char* const kBasicFragmentShader = R"(
+#version 330 core
+#include "color.glsl"
+out vec4 FragColor;
+void main() {
+    FragColor = baseColor();
+}
+)";
+
+const char* const kDefaultShaderVersion = "#version 330 core";
+const int kMaxShaderIncludeDepth = 16;
+
+struct ShaderLibrary {
+    std::unordered_map<std::string, std::string> sources;
+    std::vector<std::filesystem::path> includePaths;
+};
+
+inline ShaderLibrary& shaderLibrary() {
+    static ShaderLibrary library = [] {
+        ShaderLibrary builtins;
+        builtins.sources["color.glsl"] = kColorInclude;
+        builtins.sources["basic.vert"] = kBasicVertexShader;
+        builtins.sources["basic.frag"] = kBasicFragmentShader;
+        return builtins;
+    }();
+    return library;
+}
+
+inline bool findShaderSource(const std::string& name, std::string& source) {
+    ShaderLibrary& library = shaderLibrary();
+    auto found = library.sources.find(name);
+    if (found != library.sources.end()) {
+        source = found->second;
+        return true;
+    }
+    for (const std::filesystem::path& directory : library.includePaths) {
+        std::ifstream file(directory / name);
+        if (!file.is_open()) continue;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        source = buffer.str();
+        return true;
+    }
+    std::cerr << "Shader nao encontrado: " << name << std::endl;
+    return false;
+}
+
+// Nome entre aspas (ou <>) depois de #include; "" se a linha não for um include
+inline std::string includeName(const std::string& line) {
+    std::size_t first = line.find_first_not_of(" \t");
+    if (first == std::string::npos || line.compare(first, 8, "#include") != 0) return "";
+    std::size_t open = line.find_first_of("\"<", first + 8);
+    if (open == std::string::npos) return "";
+    std::size_t close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+    if (close == std::string::npos) return "";
+    return line.substr(open + 1, close - open - 1);
+}
+
+inline bool isVersionLine(const std::string& line) {
+    std::size_t first = line.find_first_not_of(" \t");
+    return first != std::string::npos && line.compare(first, 8, "#version") == 0;
+}
+
+// "#line" do GLSL 3.30+: a próxima linha passa a ser a linha line da fonte source
+inline void appendLineDirective(std::string& body, int line, int source) {
+    body += "#line " + std::to_string(line) + ' ' + std::to_string(source) + '\n';
+}
+
+// Expande name no fim de body; sources recebe o nome de cada número de fonte
+inline void expandShaderSource(const std::string& name, int depth, std::unordered_set<std::string>& included,
+                               std::vector<std::string>& sources, std::string& version, std::string& body) {
+    if (depth > kMaxShaderIncludeDepth) {
+        std::cerr << "Includes aninhados demais em " << name << std::endl;
+        return;
+    }
+    std::string source;
+    if (!findShaderSource(name, source)) return;
+
+    int sourceNumber = static_cast<int>(sources.size());
+    sources.push_back(name);
+    body += "// fonte " + std::to_string(sourceNumber) + ": " + name + '\n';
+    appendLineDirective(body, 1, sourceNumber);
+
+    std::istringstream lines(source);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        //#version e includes repetidos viram linhas vazias, para a numeração seguir o arquivo
+        if (isVersionLine(line)) {
+            if (depth == 0) version = line.substr(line.find_first_not_of(" \t"));
+            body += '\n';
+            continue;
+        }
+        std::string include = includeName(line);
+        if (include.empty()) {
+            body += line;
+            body += '\n';
+        } else if (included.insert(include).second) {
+            expandShaderSource(include, depth + 1, included, sources, version, body);
+            appendLineDirective(body, lineNumber + 1, sourceNumber);
+        } else {
+            body += '\n';
+        }
+    }
+}
+
+} // namespace shaderpreprocessor::detail
+
+// Registra (ou substitui) um shader da biblioteca em memória
+inline void registerShaderSource(const std::string& name, const std::string& source) {
+    shaderpreprocessor::detail::shaderLibrary().sources[name] = source;
+}
+
+// Diretório onde procurar shaders que não estão na biblioteca em memória
+inline void addShaderIncludePath(const std::filesystem::path& directory) {
+    shaderpreprocessor::detail::shaderLibrary().includePaths.push_back(directory);
+}
+
+// Código final do shader name com os defines injetados e os includes
+// expandidos. sources, se dado, recebe o nome de cada número de fonte dos #line.
+inline std::string preprocessShader(const std::string& name, const ShaderDefines& defines = {},
+                                    std::vector<std::string>* sources = nullptr) {
+    std::unordered_set<std::string> included = {name};
+    std::vector<std::string> sourceNames;
+    std::string version = shaderpreprocessor::detail::kDefaultShaderVersion;
+    std::string body;
+    shaderpreprocessor::detail::expandShaderSource(name, 0, included, sourceNames, version, body);
+    if (sources) *sources = std::move(sourceNames);
+
+    std::string result = version + '\n';
+    for (const auto& entry : defines.values)
+        result += "#define " + entry.first + (entry.second.empty() ? "" : " " + entry.second) + '\n';
+    return result + body;
+}
+
+struct ShaderPermutations {
+    std::string vertexName, fragmentName;
+    std::vector<ShaderDefines> variants;
+    std::vector<GLuint> programs;  // 0 até o primeiro uso
+    std::unordered_map<std::string, int> handles;  // chave dos defines -> variante
+};
+
+inline ShaderPermutations createShaderPermutations(const std::string& vertexName, const std::string& fragmentName) {
+    ShaderPermutations permutations;
+    permutations.vertexName = vertexName;
+    permutations.fragmentName = fragmentName;
+    return permutations;
+}
+
+// Handle da variante com esses defines; não compila nada
+inline int shaderVariant(ShaderPermutations& permutations, const ShaderDefines& defines = {}) {
+    auto found = permutations.handles.find(defines.key());
+    if (found != permutations.handles.end()) return found->second;
+
+    int handle = static_cast<int>(permutations.variants.size());
+    permutations.variants.push_back(defines);
+    permutations.programs.push_back(0);
+    permutations.handles.emplace(defines.key(), handle);
+    return handle;
+}
+
+// Programa da variante, pré-processado e compilado na primeira chamada
+inline GLuint variantProgram(ShaderPermutations& permutations, int variant) {
+    GLuint& program = permutations.programs[variant];
+    if (program == 0) {
+        const ShaderDefines& defines = permutations.variants[variant];
+        std::string vertex = preprocessShader(permutations.vertexName, defines);
+        std::string fragment = preprocessShader(permutations.fragmentName, defines);
+        program = getCachedProgram(vertex.c_str(), fragment.c_str());
+    }
+    return program;
+}
+
+// Quantas variantes já foram compiladas (as demais nunca foram usadas)
+inline int compiledVariantCount(const ShaderPermutations& permutations) {
+    int count = 0;
+    for (GLuint program : permutations.programs)
+        count += program != 0;
+    return count;
+}
+
+#endif // SHADER_PREPROCESSOR_H
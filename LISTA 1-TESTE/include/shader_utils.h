@@ -0,0 +1,59 @@
+#ifndef SHADER_UTILS_H
+#define SHADER_UTILS_H
+
+// Compilação e link de shader programs a partir do código-fonte, com o log de
+// erros de EX6. Usado pelos renderizadores dos headers compartilhados.
+
+#include <glad/glad.h>
+
+#include <iostream>
+
+// Compila um estágio (GL_VERTEX_SHADER ou GL_FRAGMENT_SHADER); erros vão para o cerr
+inline GLuint compileShaderStage(GLenum type, const char* source) {
+    int success;
+    char infoLog[512];
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        std::cerr << "Erro de compilação do " << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment")
+                  << " Shader:\n" << infoLog << std::endl;
+    }
+    return shader;
+}
+
+// Liga os dois estágios num programa; os shaders continuam sendo de quem chamou.
+// retrievable pede ao driver que guarde o binário para glGetProgramBinary.
+inline GLuint linkShaderProgram(GLuint vertexShader, GLuint fragmentShader, bool retrievable = false) {
+    int success;
+    char infoLog[512];
+
+    GLuint shaderProgram = glCreateProgram();
+    if (retrievable && glProgramParameteri)
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+    glLinkProgram(shaderProgram);
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
+        std::cerr << "Erro de linkagem do Shader Program:\n" << infoLog << std::endl;
+    }
+    glDetachShader(shaderProgram, vertexShader);
+    glDetachShader(shaderProgram, fragmentShader);
+    return shaderProgram;
+}
+
+inline GLuint buildShaderProgram(const char* vShaderSrc, const char* fShaderSrc) {
+    GLuint vertexShader = compileShaderStage(GL_VERTEX_SHADER, vShaderSrc);
+    GLuint fragmentShader = compileShaderStage(GL_FRAGMENT_SHADER, fShaderSrc);
+    GLuint shaderProgram = linkShaderProgram(vertexShader, fragmentShader);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return shaderProgram;
+}
+
+#endif // SHADER_UTILS_H
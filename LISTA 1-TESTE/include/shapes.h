@@ -0,0 +1,336 @@
+#ifndef SHAPES_H
+#define SHAPES_H
+
+// Geradores de formas 2D (EX7 e EX8): polígonos regulares, arcos, estrelas e
+// espirais, como leques/tiras de vértices (x, y, z) com z = 0.
+//
+// Cada forma tem três versões:
+//   xxxVertexCount(...)       número exato de vértices que a forma vai ter
+//   writeXxx(out, ...)        escreve os 3 * xxxVertexCount floats em out
+//                             (ponteiro para memória do chamador, buffer mapeado,
+//                             std::back_inserter...) e retorna o iterador final
+//   generateXxx(...)          conveniência que devolve um std::vector<float>
+// As versões write* não alocam memória: com um buffer já dimensionado, regenerar
+// as formas a cada quadro não passa pelo heap.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <fast_trig.h>
+#include <tessellation.h>
+
+#ifndef PI
+#define PI 3.14159265359f
+#endif
+
+// Grava divisions + 1 vértices (cx + r*cos, cy + r*sin, 0) a partir de out, com
+// ângulo = angleStart + sweep * i / divisions; r alterna entre radiusEven e
+// radiusOdd conforme a paridade de i.
+//
+// maxError == 0: seno/cosseno direto, em blocos pelo kernel SIMD. Em relação ao
+// cos/sin em double usado antes, cada coordenada difere no máximo ~radius * 8e-8
+// (ver limites em fast_trig.h); nas formas do exercício, <= 6e-8.
+// maxError > 0: rotação incremental, ressincronizando com o kernel no intervalo
+// que mantém o erro no círculo unitário <= maxError.
+template <typename OutputIt>
+OutputIt writeRimVertices(OutputIt out, int divisions, float angleStart, float sweep,
+                          float radiusEven, float radiusOdd, float cx, float cy, float maxError) {
+    const int batch = 64;  // múltiplo de fasttrig::kRotationLanes
+    float angles[batch], sines[batch], cosines[batch];
+    int count = divisions + 1;
+    //Uma única rotação para o aro inteiro: o estado passa de um bloco para o
+    //outro, e a ressincronização segue o intervalo escolhido por maxError
+    fasttrig::RotationState rotation;
+    if (maxError > 0.0f)
+        rotation = fasttrig::beginRotation(angleStart, sweep / divisions, fasttrig::resyncIntervalFor(maxError));
+    for (int base = 0; base < count; base += batch) {
+        int n = std::min(batch, count - base);
+        if (maxError > 0.0f) {
+            fasttrig::continueRotation(rotation, n, sines, cosines);
+        } else {
+            for (int k = 0; k < n; k++)
+                angles[k] = angleStart + sweep * (base + k) / divisions;
+            fasttrig::sincosBatch(angles, sines, cosines, n);
+        }
+        for (int k = 0; k < n; k++) {
+            float r = ((base + k) % 2 == 0) ? radiusEven : radiusOdd;
+            *out++ = cx + r * cosines[k];
+            *out++ = cy + r * sines[k];
+            *out++ = 0.0f;
+        }
+    }
+    return out;
+}
+
+//=== Polígono regular (leque: centro + sides + 1 vértices) ===
+
+inline std::size_t polygonVertexCount(int sides) {
+    return static_cast<std::size_t>(sides) + 2;
+}
+
+template <typename OutputIt>
+OutputIt writePolygonVertices(OutputIt out, int sides, float radius, float centerX, float centerY, float maxError = 0.0f) {
+    *out++ = centerX; // Centro X
+    *out++ = centerY; // Centro Y
+    *out++ = 0.0f;    // Z
+    return writeRimVertices(out, sides, 0.0f, 2.0f * PI, radius, radius, centerX, centerY, maxError);
+}
+
+inline std::vector<float> generatePolygonVertices(int sides, float radius, float centerX, float centerY, float maxError = 0.0f) {
+    std::vector<float> vertices(3 * polygonVertexCount(sides));
+    writePolygonVertices(vertices.data(), sides, radius, centerX, centerY, maxError);
+    return vertices;
+}
+
+//=== Arco (leque aberto: centro + segments + 1 vértices) ===
+
+// Segmentos escolhidos pelo erro em tela (ver tessellation.h)
+inline int arcSegments(float angleStart, float angleEnd, float radius) {
+    return tessellation::segmentsForArc(radius, angleEnd - angleStart);
+}
+
+inline std::size_t arcVertexCount(float angleStart, float angleEnd, float radius) {
+    return static_cast<std::size_t>(arcSegments(angleStart, angleEnd, radius)) + 2;
+}
+
+template <typename OutputIt>
+OutputIt writeArc(OutputIt out, float angleStart, float angleEnd, float radius, float centerX, float centerY, float maxError = 0.0f) {
+    int segments = arcSegments(angleStart, angleEnd, radius);
+    *out++ = centerX;
+    *out++ = centerY;
+    *out++ = 0.0f;
+    return writeRimVertices(out, segments, angleStart, angleEnd - angleStart, radius, radius, centerX, centerY, maxError);
+}
+
+inline std::vector<float> generateArc(float angleStart, float angleEnd, float radius, float centerX, float centerY, float maxError = 0.0f) {
+    std::vector<float> vertices(3 * arcVertexCount(angleStart, angleEnd, radius));
+    writeArc(vertices.data(), angleStart, angleEnd, radius, centerX, centerY, maxError);
+    return vertices;
+}
+
+//=== Estrela (leque: centro + 2 * points + 1 vértices) ===
+
+inline std::size_t starVertexCount(int points) {
+    return 2 * static_cast<std::size_t>(points) + 2;
+}
+
+template <typename OutputIt>
+OutputIt writeStar(OutputIt out, int points, float innerR, float outerR, float cx, float cy, float maxError = 0.0f) {
+    *out++ = cx;
+    *out++ = cy;
+    *out++ = 0.0f;
+    //Pontas nos índices pares, vales nos ímpares
+    return writeRimVertices(out, points * 2, 0.0f, 2.0f * PI, outerR, innerR, cx, cy, maxError);
+}
+
+inline std::vector<float> generateStar(int points, float innerR, float outerR, float cx, float cy, float maxError = 0.0f) {
+    std::vector<float> vertices(3 * starVertexCount(points));
+    writeStar(vertices.data(), points, innerR, outerR, cx, cy, maxError);
+    return vertices;
+}
+
+//=== Espiral de Arquimedes r = a * theta, theta em [0, 2 * pi * numTurns] ===
+
+//Amostragem uniforme em theta (tira: numTurns * segmentsPerTurn + 1 vértices).
+//Os vértices se acumulam no centro, onde o raio é pequeno, e ficam esparsos nas
+//voltas externas; ver as versões adaptativas abaixo.
+inline std::size_t spiralVertexCount(int numTurns, int segmentsPerTurn) {
+    return static_cast<std::size_t>(numTurns) * segmentsPerTurn + 1;
+}
+
+template <typename OutputIt>
+OutputIt writeSpiral(OutputIt out, int numTurns, int segmentsPerTurn, float maxRadius, float centerX, float centerY) {
+    int totalSegments = numTurns * segmentsPerTurn;
+
+    for (int i = 0; i <= totalSegments; i++) {
+        float t = (float)i / totalSegments;
+        float angle = 2.0f * PI * numTurns * t;
+        float radius = maxRadius * t;
+        *out++ = radius * cos(angle) + centerX;
+        *out++ = radius * sin(angle) + centerY;
+        *out++ = 0.0f;
+    }
+    return out;
+}
+
+inline std::vector<float> generateSpiral(int numTurns, int segmentsPerTurn, float maxRadius, float centerX, float centerY) {
+    std::vector<float> vertices(3 * spiralVertexCount(numTurns, segmentsPerTurn));
+    writeSpiral(vertices.data(), numTurns, segmentsPerTurn, maxRadius, centerX, centerY);
+    return vertices;
+}
+
+//Amostragem adaptativa: o passo em theta vem de uma regra local e a contagem
+//(xxxVertexCount) refaz exatamente a mesma sequência de passos.
+//  Curvature: flecha de cada corda <= maxError (unidades da cena). Com curvatura
+//             k, a corda de comprimento s se afasta s^2 * k / 8 da curva, logo
+//             s = sqrt(8 * maxError / k). Longe do centro equivale a
+//             segmentsForArc no raio local: ~2/3 dos vértices da versão
+//             uniforme dimensionada pelo raio máximo.
+//  ArcLength: vértices igualmente espaçados ao longo da curva (spacing).
+enum class SpiralSampling { Curvature, ArcLength };
+
+namespace shapes::detail {
+
+//Passo máximo em theta, para o centro não virar um polígono grosseiro
+constexpr float kMaxSpiralStep = PI / 8;
+//Passo mínimo, como fração de thetaMax. A tolerância é elevada de antemão
+//(spiralMinTolerance) para que nenhum passo fique abaixo dele; o piso no laço
+//só cobre arredondamento e a == 0. Como o ulp de thetaMax (~1.2e-7 * thetaMax)
+//é bem menor que o passo, theta + passo sempre avança e a espiral tem no
+//máximo ~32768 * (1 + 2^-8) + 1 amostras.
+constexpr float kMinSpiralStepFraction = 1.0f / 32768;
+
+//a de r = a * theta; 0 se a espiral não tiver voltas
+inline float spiralCoefficient(float maxRadius, float thetaMax) {
+    return thetaMax > 0.0f ? maxRadius / thetaMax : 0.0f;
+}
+
+inline float spiralStep(SpiralSampling sampling, float a, float theta, float tolerance) {
+    float r = a * theta;
+    float r2a2 = r * r + a * a;
+    float speed = std::sqrt(r2a2); //ds/dtheta
+    if (speed == 0.0f) return kMaxSpiralStep; //a == 0: a espiral é um ponto
+    float arc = tolerance;
+    if (sampling == SpiralSampling::Curvature) {
+        float curvature = (r * r + 2.0f * a * a) / (r2a2 * speed);
+        arc = std::sqrt(8.0f * tolerance / curvature);
+    }
+    return std::min(arc / speed, kMaxSpiralStep);
+}
+
+//Menor tolerância cujo passo nunca fica abaixo de minStep em [0, thetaMax].
+//ds/dtheta e curvatura * (ds/dtheta)^2 = (r^2 + 2a^2) / sqrt(r^2 + a^2)
+//crescem com r, então o pior caso é a ponta externa (r = a * thetaMax).
+inline float spiralMinTolerance(SpiralSampling sampling, float a, float thetaMax, float minStep) {
+    float r = a * thetaMax;
+    float r2a2 = r * r + a * a;
+    if (sampling == SpiralSampling::ArcLength) return std::sqrt(r2a2) * minStep;
+    return (r * r + 2.0f * a * a) / std::sqrt(r2a2) * minStep * minStep / 8.0f;
+}
+
+//Chama visit(theta) para cada amostra; a última é exatamente thetaMax.
+//thetaMax <= 0 (numTurns <= 0) dá uma amostra só, no centro.
+template <typename Visit>
+void forEachSpiralSample(SpiralSampling sampling, float a, float thetaMax, float tolerance, Visit visit) {
+    float theta = 0.0f;
+    visit(theta);
+    if (!(thetaMax > 0.0f)) return;
+    const float minStep = thetaMax * kMinSpiralStepFraction;
+    float minTolerance = spiralMinTolerance(sampling, a, thetaMax, minStep);
+    if (!(tolerance >= minTolerance)) tolerance = minTolerance; //também pega tolerance <= 0 ou NaN
+    while (theta < thetaMax) {
+        float step = spiralStep(sampling, a, theta, tolerance);
+        if (!(step >= minStep)) step = minStep; //arredondamento; NaN se a == 0
+        theta = std::min(theta + step, thetaMax);
+        visit(theta);
+    }
+}
+
+} // namespace shapes::detail
+
+inline std::size_t spiralAdaptiveVertexCount(SpiralSampling sampling, int numTurns, float maxRadius, float tolerance) {
+    float thetaMax = 2.0f * PI * numTurns;
+    std::size_t count = 0;
+    shapes::detail::forEachSpiralSample(sampling, shapes::detail::spiralCoefficient(maxRadius, thetaMax), thetaMax, tolerance,
+                                [&](float) { count++; });
+    return count;
+}
+
+//tolerance é a flecha máxima (Curvature) ou o espaçamento (ArcLength), nas
+//unidades da cena; tessellation::pixelErrorToNdc converte de pixels
+template <typename OutputIt>
+OutputIt writeSpiralAdaptive(OutputIt out, SpiralSampling sampling, int numTurns, float maxRadius, float tolerance,
+                             float centerX, float centerY) {
+    const int batch = 64;
+    float angles[batch], sines[batch], cosines[batch];
+    int pending = 0;
+    float thetaMax = 2.0f * PI * numTurns;
+    float a = shapes::detail::spiralCoefficient(maxRadius, thetaMax);
+
+    auto flush = [&]() {
+        fasttrig::sincosBatch(angles, sines, cosines, pending);
+        for (int k = 0; k < pending; k++) {
+            float radius = a * angles[k];
+            *out++ = radius * cosines[k] + centerX;
+            *out++ = radius * sines[k] + centerY;
+            *out++ = 0.0f;
+        }
+        pending = 0;
+    };
+    shapes::detail::forEachSpiralSample(sampling, a, thetaMax, tolerance, [&](float theta) {
+        angles[pending++] = theta;
+        if (pending == batch) flush();
+    });
+    flush();
+    return out;
+}
+
+inline std::vector<float> generateSpiralAdaptive(SpiralSampling sampling, int numTurns, float maxRadius, float tolerance,
+                                                 float centerX, float centerY) {
+    std::vector<float> vertices(3 * spiralAdaptiveVertexCount(sampling, numTurns, maxRadius, tolerance));
+    writeSpiralAdaptive(vertices.data(), sampling, numTurns, maxRadius, tolerance, centerX, centerY);
+    return vertices;
+}
+
+//=== Tabelas em tempo de compilação ===
+
+//Leques no círculo unitário (centro + contorno), prontos para escalar e
+//transladar sem nenhuma chamada de seno/cosseno em tempo de execução
+template <int Sides>
+constexpr std::array<float, 3 * (Sides + 2)> generatePolygonVertices() {
+    static_assert(Sides >= 3, "um poligono precisa de pelo menos 3 lados");
+    std::array<float, 3 * (Sides + 2)> vertices{}; //Centro em (0, 0, 0)
+    for (int i = 0; i <= Sides; i++) {
+        double angle = 2.0 * fasttrig::kPi * i / Sides;
+        vertices[3 * (i + 1)]     = static_cast<float>(fasttrig::constexprCos(angle));
+        vertices[3 * (i + 1) + 1] = static_cast<float>(fasttrig::constexprSin(angle));
+    }
+    return vertices;
+}
+
+//Direções unitárias da estrela; as pontas (índices pares do contorno) e os vales
+//(ímpares) recebem o raio só em writeUnitFan
+template <int Points>
+constexpr std::array<float, 3 * (Points * 2 + 2)> generateStar() {
+    static_assert(Points >= 2, "uma estrela precisa de pelo menos 2 pontas");
+    std::array<float, 3 * (Points * 2 + 2)> vertices{};
+    for (int i = 0; i <= Points * 2; i++) {
+        double angle = i * fasttrig::kPi / Points;
+        vertices[3 * (i + 1)]     = static_cast<float>(fasttrig::constexprCos(angle));
+        vertices[3 * (i + 1) + 1] = static_cast<float>(fasttrig::constexprSin(angle));
+    }
+    return vertices;
+}
+
+//Escala e translada um leque unitário (N / 3 vértices); o raio alterna entre
+//radiusEven e radiusOdd pela paridade do vértice do contorno (iguais para polígonos)
+template <typename OutputIt, std::size_t N>
+OutputIt writeUnitFan(OutputIt out, const std::array<float, N>& unitFan, float radiusEven, float radiusOdd, float cx, float cy) {
+    *out++ = cx;
+    *out++ = cy;
+    *out++ = 0.0f;
+    for (std::size_t i = 3; i < N; i += 3) {
+        float r = ((i / 3 - 1) % 2 == 0) ? radiusEven : radiusOdd;
+        *out++ = cx + r * unitFan[i];
+        *out++ = cy + r * unitFan[i + 1];
+        *out++ = 0.0f;
+    }
+    return out;
+}
+
+template <std::size_t N>
+std::vector<float> placeUnitFan(const std::array<float, N>& unitFan, float radiusEven, float radiusOdd, float cx, float cy) {
+    std::vector<float> vertices(N);
+    writeUnitFan(vertices.data(), unitFan, radiusEven, radiusOdd, cx, cy);
+    return vertices;
+}
+
+template <std::size_t N>
+std::vector<float> placeUnitFan(const std::array<float, N>& unitFan, float radius, float cx, float cy) {
+    return placeUnitFan(unitFan, radius, radius, cx, cy);
+}
+
+#endif // SHAPES_H
@@ -0,0 +1,159 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+// Buffer de vértices para geometria que muda a cada quadro.
+//
+// Reenviar com glBufferData todo quadro pode travar o pipeline: o driver
+// espera a GPU terminar de ler o conteúdo antigo. Aqui o buffer é dividido
+// num anel de regiões, uma por quadro em voo. Cada quadro escreve só na sua
+// região, mapeada com GL_MAP_UNSYNCHRONIZED_BIT (sem espera implícita), e
+// termina com um glFenceSync. Antes de reutilizar uma região, esperamos a
+// fence dela, que normalmente já foi sinalizada. Assim a CPU escreve o quadro
+// N + 1 enquanto a GPU ainda lê o quadro N.
+//
+// Uso por quadro:
+//   beginStreamFrame(stream);
+//   StreamSpan span = streamAllocate(stream, vertexCount, 3 * sizeof(float));
+//   ... escreve span.data ...
+//   if (streamCommit(stream, span))
+//       glDrawArrays(mode, span.firstVertex, vertexCount);
+//   endStreamFrame(stream);
+// O VAO aponta o atributo para o início do buffer (offset 0); span.firstVertex
+// já inclui o deslocamento da região.
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <iostream>
+
+#include <gl_state.h>
+
+struct StreamSpan {
+    void* data = nullptr;      // memória mapeada, válida até streamCommit
+    std::size_t bytes = 0;
+    GLintptr offset = 0;       // em bytes, a partir do início do buffer
+    GLint firstVertex = 0;     // offset / stride, para glDrawArrays
+};
+
+struct StreamBuffer {
+    static const int kMaxRegions = 4;
+    GLuint VBO = 0;
+    GLenum target = GL_ARRAY_BUFFER;
+    std::size_t regionBytes = 0;
+    int regionCount = 0;
+    int region = 0;              // região do quadro atual
+    std::size_t used = 0;        // bytes já alocados na região atual
+    GLsync fences[kMaxRegions] = {};
+};
+
+namespace streambuffer::detail {
+
+inline void waitStreamFence(GLsync& fence) {
+    if (!fence) return;
+    //Normalmente a fence já foi sinalizada; só espera se a GPU estiver
+    //regionCount quadros atrás
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+    glDeleteSync(fence);
+    fence = 0;
+}
+
+} // namespace streambuffer::detail
+
+// regionBytes: o máximo que um quadro pode escrever; regionCount: quadros em voo (2 a 4)
+inline StreamBuffer createStreamBuffer(std::size_t regionBytes, int regionCount = 3, GLenum target = GL_ARRAY_BUFFER) {
+    StreamBuffer stream;
+    stream.target = target;
+    stream.regionBytes = regionBytes;
+    stream.regionCount = regionCount < 1 ? 1 : (regionCount > StreamBuffer::kMaxRegions ? StreamBuffer::kMaxRegions : regionCount);
+    stream.region = stream.regionCount - 1; //o primeiro beginStreamFrame avança para a região 0
+
+    glGenBuffers(1, &stream.VBO);
+    glstate::bindBuffer(target, stream.VBO);
+    glBufferData(target, stream.regionBytes * stream.regionCount, NULL, GL_STREAM_DRAW);
+    return stream;
+}
+
+// Garante regiões de pelo menos regionBytes. Se precisar crescer, realoca o
+// buffer (o driver mantém o antigo vivo até a GPU terminar). Chamar entre
+// quadros, fora de begin/endStreamFrame.
+inline void reserveStreamBuffer(StreamBuffer& stream, std::size_t regionBytes) {
+    if (regionBytes <= stream.regionBytes) return;
+    for (int i = 0; i < stream.regionCount; i++) {
+        if (stream.fences[i]) glDeleteSync(stream.fences[i]);
+        stream.fences[i] = 0;
+    }
+    stream.regionBytes = regionBytes;
+    stream.region = stream.regionCount - 1;
+    stream.used = 0;
+    glstate::bindBuffer(stream.target, stream.VBO);
+    glBufferData(stream.target, stream.regionBytes * stream.regionCount, NULL, GL_STREAM_DRAW);
+}
+
+// Passa para a próxima região do anel, esperando a GPU liberá-la se preciso
+inline void beginStreamFrame(StreamBuffer& stream) {
+    stream.region = (stream.region + 1) % stream.regionCount;
+    stream.used = 0;
+    streambuffer::detail::waitStreamFence(stream.fences[stream.region]);
+}
+
+// Reserva vertexCount vértices de stride bytes na região atual e mapeia para
+// escrita. Retorna um span vazio (data == nullptr) se a região não comporta.
+inline StreamSpan streamAllocate(StreamBuffer& stream, std::size_t vertexCount, std::size_t stride) {
+    StreamSpan span;
+    std::size_t regionStart = stream.region * stream.regionBytes;
+    //Alinha ao stride (a partir do início do buffer) para que firstVertex seja inteiro
+    std::size_t offset = regionStart + stream.used;
+    offset = (offset + stride - 1) / stride * stride;
+    std::size_t bytes = vertexCount * stride;
+    if (bytes == 0 || offset + bytes > regionStart + stream.regionBytes)
+        return span;
+
+    glstate::bindBuffer(stream.target, stream.VBO);
+    span.data = glMapBufferRange(stream.target, offset, bytes,
+                                 GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (!span.data)
+        return StreamSpan();
+    span.bytes = bytes;
+    span.offset = static_cast<GLintptr>(offset);
+    span.firstVertex = static_cast<GLint>(offset / stride);
+    stream.used = offset + bytes - regionStart;
+    return span;
+}
+
+// Quantos vértices de stride bytes ainda cabem na região atual
+inline std::size_t streamCapacity(const StreamBuffer& stream, std::size_t stride) {
+    std::size_t regionStart = stream.region * stream.regionBytes;
+    std::size_t offset = (regionStart + stream.used + stride - 1) / stride * stride;
+    std::size_t regionEnd = regionStart + stream.regionBytes;
+    return offset < regionEnd ? (regionEnd - offset) / stride : 0;
+}
+
+// Fecha o mapeamento do span; deve vir antes do draw que o lê. Retorna false
+// se o conteúdo foi perdido (glUnmapBuffer == GL_FALSE, ex.: troca de modo de
+// vídeo): o span não deve ser desenhado neste quadro.
+inline bool streamCommit(StreamBuffer& stream, StreamSpan& span) {
+    if (!span.data) return false;
+    glstate::bindBuffer(stream.target, stream.VBO);
+    GLboolean intact = glUnmapBuffer(stream.target);
+    span.data = nullptr;
+    if (intact == GL_FALSE) {
+        std::cerr << "Conteudo do stream buffer perdido; draw descartado" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Marca o fim dos draws que leem a região atual
+inline void endStreamFrame(StreamBuffer& stream) {
+    stream.fences[stream.region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+inline void deleteStreamBuffer(StreamBuffer& stream) {
+    for (int i = 0; i < stream.regionCount; i++)
+        if (stream.fences[i]) glDeleteSync(stream.fences[i]);
+    glstate::onDeleteBuffer(stream.VBO);
+    glDeleteBuffers(1, &stream.VBO);
+    stream = StreamBuffer();
+}
+
+#endif // STREAM_BUFFER_H
@@ -0,0 +1,73 @@
+#ifndef TESSELLATION_H
+#define TESSELLATION_H
+
+// Escolha do número de segmentos de curvas a partir de um erro máximo em pixels.
+//
+// Uma corda que cobre o ângulo theta num círculo de raio r (em pixels) se afasta
+// do arco no máximo r * (1 - cos(theta / 2)) (a flecha). Invertendo:
+//   theta = 2 * acos(1 - erro / r)
+// e o número de segmentos de uma varredura é ceil(varredura / theta).
+//
+// O raio é dado em coordenadas normalizadas (NDC); a conversão para pixels usa
+// o tamanho atual do framebuffer, que os exercícios atualizam no
+// framebuffer_size_callback via setFramebufferSize.
+
+#include <algorithm>
+#include <cmath>
+
+namespace tessellation {
+
+// Erro padrão: um quarto de pixel
+constexpr float kDefaultMaxChordErrorPx = 0.25f;
+
+namespace detail {
+
+struct FramebufferSize {
+    int width = 800;
+    int height = 600;
+};
+
+inline FramebufferSize& framebufferSize() {
+    static FramebufferSize size;
+    return size;
+}
+
+} // namespace detail
+
+inline void setFramebufferSize(int width, int height) {
+    detail::framebufferSize().width = width;
+    detail::framebufferSize().height = height;
+}
+
+inline int framebufferWidth() { return detail::framebufferSize().width; }
+inline int framebufferHeight() { return detail::framebufferSize().height; }
+
+// Pixels por unidade NDC no eixo maior (a NDC vai de -1 a 1, então metade da
+// largura/altura). Usar o eixo maior é conservador com janelas não quadradas.
+inline float pixelsPerNdcUnit() {
+    const detail::FramebufferSize& size = detail::framebufferSize();
+    return 0.5f * static_cast<float>(std::max(size.width, size.height));
+}
+
+// Erro em pixels convertido para unidades NDC, para amostragens que trabalham
+// direto em coordenadas da cena
+inline float pixelErrorToNdc(float errorPx = kDefaultMaxChordErrorPx) {
+    return errorPx / pixelsPerNdcUnit();
+}
+
+// Segmentos para aproximar um arco de raio radius (NDC) e varredura sweep
+// (radianos) com flecha <= maxChordErrorPx em tela
+inline int segmentsForArc(float radius, float sweep, float maxChordErrorPx = kDefaultMaxChordErrorPx,
+                          int minSegments = 3, int maxSegments = 4096) {
+    if (maxChordErrorPx <= 0.0f) return maxSegments;
+    float radiusPx = std::fabs(radius) * pixelsPerNdcUnit();
+    if (radiusPx <= maxChordErrorPx) return minSegments;
+
+    float theta = 2.0f * std::acos(1.0f - maxChordErrorPx / radiusPx);
+    int segments = static_cast<int>(std::ceil(std::fabs(sweep) / theta));
+    return std::clamp(segments, minSegments, maxSegments);
+}
+
+} // namespace tessellation
+
+#endif // TESSELLATION_H
@@ -0,0 +1,115 @@
+#ifndef VERTEX_FORMATS_H
+#define VERTEX_FORMATS_H
+
+// Formatos de vértice compactos para cenas 2D.
+//
+// Nos exercícios z é sempre 0 e as coordenadas já estão em NDC ([-1, 1]), então
+// a posição cabe em dois inteiros de 16 bits normalizados (GL_SHORT com
+// normalized = GL_TRUE) ou em dois half floats (GL_HALF_FLOAT). A cor vira
+// RGBA8 normalizado. De 6 floats (24 bytes) para 8 bytes por vértice.
+//
+// Os shaders não mudam: um atributo com 2 componentes lido como vec3/vec4
+// recebe z = 0 e w = 1, e um vec3 que recebe 4 componentes ignora o alfa.
+//
+// Precisão em NDC: snorm16 tem passo fixo de 1/32767 (~3e-5, bem abaixo de um
+// pixel até 60k pixels); half tem passo relativo de 2^-11, ou seja, ~5e-4 perto
+// de ±1 (1/4 de pixel numa janela de 1000 pixels) e mais fino perto do centro.
+
+#include <glad/glad.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <vertex_layout.h>
+
+enum class PositionFormat { Snorm16, Half };
+
+// 8 bytes: x, y no formato escolhido + cor RGBA8
+struct PackedVertex2D {
+    std::uint16_t x, y;        // bits de um int16 normalizado ou de um half
+    std::uint8_t r, g, b, a;
+};
+static_assert(sizeof(PackedVertex2D) == 8, "PackedVertex2D deve ter 8 bytes");
+
+// [-1, 1] -> int16, c / 32767 na leitura (conversão do GL 4.2+, adotada também
+// pelos drivers em contextos 3.3)
+constexpr std::int16_t toSnorm16(float v) {
+    return static_cast<std::int16_t>(v >= 1.0f ? 32767 : v <= -1.0f ? -32767
+                                     : (v >= 0.0f ? v * 32767.0f + 0.5f : v * 32767.0f - 0.5f));
+}
+
+// [0, 1] -> uint8
+constexpr std::uint8_t toUnorm8(float v) {
+    return static_cast<std::uint8_t>(v >= 1.0f ? 255 : v <= 0.0f ? 0 : v * 255.0f + 0.5f);
+}
+
+// float -> half (IEEE 754 binary16), arredondando para o par mais próximo
+inline std::uint16_t toHalf(float v) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    std::uint32_t sign = (bits >> 16) & 0x8000u;
+    std::uint32_t absBits = bits & 0x7FFFFFFFu;
+
+    if (absBits >= 0x7F800000u) //inf ou NaN
+        return static_cast<std::uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x200u : 0u));
+    if (absBits >= 0x477FF000u) //arredonda para além do maior half finito
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    if (absBits < 0x38800000u) { //subnormal (ou zero) em half
+        if (absBits < 0x33000000u) return static_cast<std::uint16_t>(sign);
+        std::uint32_t mantissa = (absBits & 0x7FFFFFu) | 0x800000u;
+        int shift = 126 - static_cast<int>(absBits >> 23);  // 14..24
+        std::uint32_t half = mantissa >> shift;
+        std::uint32_t rest = mantissa & ((1u << shift) - 1);
+        std::uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+        return static_cast<std::uint16_t>(sign | half);
+    }
+    std::uint32_t half = (absBits - 0x38000000u) >> 13;
+    std::uint32_t rest = absBits & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++; //pode subir o expoente: correto
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+inline std::uint16_t packPosition(float v, PositionFormat format) {
+    return format == PositionFormat::Half ? toHalf(v) : static_cast<std::uint16_t>(toSnorm16(v));
+}
+
+inline PackedVertex2D packVertex2D(float x, float y, float r, float g, float b, float a, PositionFormat format) {
+    PackedVertex2D vertex;
+    vertex.x = packPosition(x, format);
+    vertex.y = packPosition(y, format);
+    vertex.r = toUnorm8(r);
+    vertex.g = toUnorm8(g);
+    vertex.b = toUnorm8(b);
+    vertex.a = toUnorm8(a);
+    return vertex;
+}
+
+// Converte vertexCount posições x, y, z (saída dos geradores de shapes.h) em
+// pares x, y compactos; z é descartado. Retorna o fim da saída.
+inline std::uint16_t* packPositions2D(const float* xyz, std::size_t vertexCount, PositionFormat format, std::uint16_t* out) {
+    for (std::size_t i = 0; i < vertexCount; i++) {
+        *out++ = packPosition(xyz[3 * i], format);
+        *out++ = packPosition(xyz[3 * i + 1], format);
+    }
+    return out;
+}
+
+// Layout de PackedVertex2D: posição em location 0 e cor RGBA8 em location 1.
+// x e y são uint16_t guardando bits: o tipo GL da posição é dado explicitamente.
+inline constexpr auto kPackedVertex2DLayout = makeVertexLayout<PackedVertex2D>(
+    withType(VERTEX_ATTRIBUTE_N(PackedVertex2D, x, 2, 0, true), GL_SHORT, true),
+    VERTEX_ATTRIBUTE_N(PackedVertex2D, r, 4, 1, true));
+
+// Mesmo layout com a posição lida como half
+inline constexpr auto kPackedVertex2DHalfLayout = makeVertexLayout<PackedVertex2D>(
+    withType(VERTEX_ATTRIBUTE_N(PackedVertex2D, x, 2, 0, false), GL_HALF_FLOAT, false),
+    VERTEX_ATTRIBUTE_N(PackedVertex2D, r, 4, 1, true));
+
+inline const VertexLayout<PackedVertex2D, 2>& packedVertex2DLayout(PositionFormat format) {
+    return format == PositionFormat::Half ? kPackedVertex2DHalfLayout : kPackedVertex2DLayout;
+}
+
+#endif // VERTEX_FORMATS_H
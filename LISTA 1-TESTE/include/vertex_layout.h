@@ -0,0 +1,178 @@
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+// Descrição de layout de vértice em tempo de compilação.
+//
+// Em vez de escrever stride e offset à mão em cada glVertexAttribPointer, o
+// layout é derivado da struct do vértice: tipo GL, número de componentes e
+// offset de cada atributo saem do tipo e de offsetof do campo.
+//
+//   struct ColorVertex { float pos[3]; std::uint8_t color[4]; };
+//   constexpr auto kColorVertexLayout = makeVertexLayout<ColorVertex>(
+//       VERTEX_ATTRIBUTE(ColorVertex, pos, 0, false),
+//       VERTEX_ATTRIBUTE(ColorVertex, color, 1, true));
+//   uploadVertices(VAO, VBO, kColorVertexLayout, vertices, n, VertexStorage::Interleaved);
+//
+// O mesmo layout serve para os dois armazenamentos:
+//   Interleaved (AoS): o array de vértices vai para o VBO como está; todos os
+//       atributos com stride sizeof(Vertex).
+//   Split (SoA): cada atributo vira um fluxo contíguo no VBO (todas as posições,
+//       depois todas as cores...), com stride igual ao tamanho do atributo.
+// Os dois alimentam os mesmos locations, então o código de desenho não muda.
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gl_state.h>
+
+struct VertexAttribute {
+    GLuint location = 0;
+    GLint components = 0;
+    GLenum type = GL_FLOAT;
+    GLboolean normalized = GL_FALSE;
+    std::size_t offset = 0;         // dentro da struct do vértice
+    std::size_t componentSize = 0;  // bytes por componente
+
+    constexpr std::size_t size() const { return components * componentSize; }
+};
+
+// Tipo C++ do componente -> enum do GL
+template <typename T> struct GlComponentType;
+template <> struct GlComponentType<float>         { static constexpr GLenum value = GL_FLOAT; };
+template <> struct GlComponentType<std::int8_t>   { static constexpr GLenum value = GL_BYTE; };
+template <> struct GlComponentType<std::uint8_t>  { static constexpr GLenum value = GL_UNSIGNED_BYTE; };
+template <> struct GlComponentType<std::int16_t>  { static constexpr GLenum value = GL_SHORT; };
+template <> struct GlComponentType<std::uint16_t> { static constexpr GLenum value = GL_UNSIGNED_SHORT; };
+template <> struct GlComponentType<std::int32_t>  { static constexpr GLenum value = GL_INT; };
+template <> struct GlComponentType<std::uint32_t> { static constexpr GLenum value = GL_UNSIGNED_INT; };
+
+// Campo escalar: 1 componente; array T[N]: N componentes
+template <typename Field> struct FieldTraits {
+    using Component = Field;
+    static constexpr GLint components = 1;
+};
+template <typename T, std::size_t N> struct FieldTraits<T[N]> {
+    using Component = T;
+    static constexpr GLint components = static_cast<GLint>(N);
+};
+
+template <typename Field>
+constexpr VertexAttribute makeVertexAttribute(GLuint location, std::size_t offset, GLint components, bool normalized) {
+    using Component = typename FieldTraits<Field>::Component;
+    VertexAttribute attribute;
+    attribute.location = location;
+    attribute.components = components;
+    attribute.type = GlComponentType<Component>::value;
+    attribute.normalized = normalized ? GL_TRUE : GL_FALSE;
+    attribute.offset = offset;
+    attribute.componentSize = sizeof(Component);
+    return attribute;
+}
+
+// Mesmo atributo com outro tipo GL de mesmo tamanho (ex.: uint16_t guardando GL_HALF_FLOAT)
+constexpr VertexAttribute withType(VertexAttribute attribute, GLenum type, bool normalized) {
+    attribute.type = type;
+    attribute.normalized = normalized ? GL_TRUE : GL_FALSE;
+    return attribute;
+}
+
+// Atributo a partir de um campo da struct; o número de componentes vem do tipo do campo
+#define VERTEX_ATTRIBUTE(Vertex, member, location, normalized) \
+    makeVertexAttribute<decltype(Vertex::member)>((location), offsetof(Vertex, member), \
+                                                  FieldTraits<decltype(Vertex::member)>::components, (normalized))
+
+// Atributo formado por components campos escalares consecutivos a partir de firstMember (ex.: x, y)
+#define VERTEX_ATTRIBUTE_N(Vertex, firstMember, components, location, normalized) \
+    makeVertexAttribute<decltype(Vertex::firstMember)>((location), offsetof(Vertex, firstMember), (components), (normalized))
+
+template <typename Vertex, std::size_t N>
+struct VertexLayout {
+    std::array<VertexAttribute, N> attributes;
+    static constexpr std::size_t stride = sizeof(Vertex);
+};
+
+template <typename Vertex, typename... Attributes>
+constexpr VertexLayout<Vertex, sizeof...(Attributes)> makeVertexLayout(Attributes... attributes) {
+    return VertexLayout<Vertex, sizeof...(Attributes)>{{{attributes...}}};
+}
+
+enum class VertexStorage { Interleaved, Split };
+
+namespace vertexlayout::detail {
+
+inline void setVertexAttribute(const VertexAttribute& attribute, GLsizei stride, std::size_t offset) {
+    glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                          stride, (void*)offset);
+    glEnableVertexAttribArray(attribute.location);
+}
+
+// Fluxos SoA começam alinhados a 4 bytes
+constexpr std::size_t alignStream(std::size_t offset) {
+    return (offset + 3) / 4 * 4;
+}
+
+} // namespace vertexlayout::detail
+
+// Configura os atributos do VAO ligado para vértices intercalados no
+// GL_ARRAY_BUFFER ligado, a partir de baseOffset bytes
+template <typename Vertex, std::size_t N>
+void setInterleavedLayout(const VertexLayout<Vertex, N>& layout, std::size_t baseOffset = 0) {
+    for (const VertexAttribute& attribute : layout.attributes)
+        vertexlayout::detail::setVertexAttribute(attribute, static_cast<GLsizei>(layout.stride), baseOffset + attribute.offset);
+}
+
+// Configura os atributos do VAO ligado para count vértices em fluxos separados
+// no GL_ARRAY_BUFFER ligado, na ordem do layout. Retorna o tamanho total em bytes.
+template <typename Vertex, std::size_t N>
+std::size_t setSplitLayout(const VertexLayout<Vertex, N>& layout, std::size_t count, std::size_t baseOffset = 0) {
+    std::size_t offset = baseOffset;
+    for (const VertexAttribute& attribute : layout.attributes) {
+        offset = vertexlayout::detail::alignStream(offset);
+        vertexlayout::detail::setVertexAttribute(attribute, static_cast<GLsizei>(attribute.size()), offset);
+        offset += attribute.size() * count;
+    }
+    return offset - baseOffset;
+}
+
+// Reorganiza count vértices em fluxos separados (mesmo formato de setSplitLayout)
+template <typename Vertex, std::size_t N>
+void splitVertices(const VertexLayout<Vertex, N>& layout, const Vertex* vertices, std::size_t count,
+                   std::vector<unsigned char>& out) {
+    std::size_t offset = 0;
+    for (const VertexAttribute& attribute : layout.attributes)
+        offset = vertexlayout::detail::alignStream(offset) + attribute.size() * count;
+    out.assign(offset, 0);
+
+    offset = 0;
+    for (const VertexAttribute& attribute : layout.attributes) {
+        offset = vertexlayout::detail::alignStream(offset);
+        const unsigned char* src = reinterpret_cast<const unsigned char*>(vertices) + attribute.offset;
+        for (std::size_t i = 0; i < count; i++)
+            std::memcpy(&out[offset + i * attribute.size()], src + i * sizeof(Vertex), attribute.size());
+        offset += attribute.size() * count;
+    }
+}
+
+// Envia count vértices para VBO e configura VAO, no armazenamento escolhido
+template <typename Vertex, std::size_t N>
+void uploadVertices(GLuint VAO, GLuint VBO, const VertexLayout<Vertex, N>& layout, const Vertex* vertices,
+                    std::size_t count, VertexStorage storage, GLenum usage = GL_STATIC_DRAW) {
+    glstate::bindVertexArray(VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (storage == VertexStorage::Split) {
+        std::vector<unsigned char> streams;
+        splitVertices(layout, vertices, count, streams);
+        glBufferData(GL_ARRAY_BUFFER, streams.size(), streams.data(), usage);
+        setSplitLayout(layout, count);
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, count * sizeof(Vertex), vertices, usage);
+        setInterleavedLayout(layout);
+    }
+}
+
+#endif // VERTEX_LAYOUT_H
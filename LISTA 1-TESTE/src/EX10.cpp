@@ -1,6 +1,17 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <cstdint>
 #include <iostream>
+#include <string>
+
+#include <async_shaders.h>
+#include <frame_pacing.h>
+#include <geometry_pool.h>
+#include <gl_state.h>
+#include <mesh.h>
+#include <render_loop.h>
+#include <shader_cache.h>
+#include <shader_preprocessor.h>
 
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
@@ -9,26 +20,7 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
-//Compilação de shaders
-unsigned int createShaderProgram(const char* vShaderSrc, const char* fShaderSrc) {
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vShaderSrc, NULL);
-    glCompileShader(vertexShader);
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fShaderSrc, NULL);
-    glCompileShader(fragmentShader);
-
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return shaderProgram;
-}
-
-int main() {
+int main(int argc, char** argv) {
     //Inicializa GLFW
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -41,38 +33,49 @@ int main() {
     }
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    //--on-demand: só redesenha em redimensionamento, exposição ou entrada
+    setupRenderLoop(window, argc, argv);
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         return -1;
     }
 
-    //=== Dados da base da casa (quadrado) ===
+    //Ritmo de quadros: --vsync (padrão), --uncapped, --fps N, --max-frames N
+    FramePacer pacer = createFramePacer(argc, argv);
+
+    //Programas ligados vão para o disco: as próximas execuções não recompilam
+    enableProgramBinaryCache("shader_cache");
+
+    //=== Base, telhado e porta numa malha indexada ===
+    //Os retângulos usam 4 vértices e 6 índices em vez de 6 vértices
+    IndexedMesh houseMesh;
+
+    //Base da casa (quadrado)
     float baseVertices[] = {
         -0.5f, -0.5f, 0.0f,  //Inferior esquerdo
          0.5f, -0.5f, 0.0f,  //Inferior direito
          0.5f,  0.0f, 0.0f,  //Superior direito
-
-        -0.5f, -0.5f, 0.0f,
-         0.5f,  0.0f, 0.0f,
         -0.5f,  0.0f, 0.0f   //Superior esquerdo
     };
+    const std::uint32_t quadIndices[] = { 0, 1, 2,  0, 2, 3 };
+    houseMesh.appendTriangles(baseVertices, 4, quadIndices, 6);
 
-    //=== Dados do telhado (triângulo) ===
+    //Telhado (triângulo)
     float roofVertices[] = {
         -0.6f,  0.0f, 0.0f,
          0.6f,  0.0f, 0.0f,
          0.0f,  0.5f, 0.0f
     };
+    const std::uint32_t roofIndices[] = { 0, 1, 2 };
+    houseMesh.appendTriangles(roofVertices, 3, roofIndices, 3);
 
-    //=== Dados da porta (retângulo) ===
+    //Porta (retângulo)
     float doorVertices[] = {
         -0.1f, -0.5f, 0.0f,
          0.1f, -0.5f, 0.0f,
          0.1f, -0.2f, 0.0f,
-
-        -0.1f, -0.5f, 0.0f,
-         0.1f, -0.2f, 0.0f,
         -0.1f, -0.2f, 0.0f
     };
+    houseMesh.appendTriangles(doorVertices, 4, quadIndices, 6);
 
     //=== Dados da janela (pontos) ===
     float windowPoints[] = {
@@ -82,90 +85,66 @@ int main() {
         -0.15f,  0.1f, 0.0f
     };
 
-    //Shader simples
-    const char* vertexShaderSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPos;
-        void main() {
-            gl_Position = vec4(aPos, 1.0);
-        }
-    )";
-
-    const char* fragmentShaderSource = R"(
-        #version 330 core
-        out vec4 FragColor;
-        void main() {
-            FragColor = vec4(0.8, 0.6, 0.2, 1.0);
-        }
-    )";
-
-    unsigned int shaderProgram = createShaderProgram(vertexShaderSource, fragmentShaderSource);
-
-    //==== VAOs e VBOs ====
-    unsigned int VAOs[4], VBOs[4];
-    glGenVertexArrays(4, VAOs);
-    glGenBuffers(4, VBOs);
-
-    //Base da casa
-    glBindVertexArray(VAOs[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, VBOs[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(baseVertices), baseVertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    //Telhado
-    glBindVertexArray(VAOs[1]);
-    glBindBuffer(GL_ARRAY_BUFFER, VBOs[1]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(roofVertices), roofVertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    //Porta
-    glBindVertexArray(VAOs[2]);
-    glBindBuffer(GL_ARRAY_BUFFER, VBOs[2]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(doorVertices), doorVertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    //Janela (pontos)
-    glBindVertexArray(VAOs[3]);
-    glBindBuffer(GL_ARRAY_BUFFER, VBOs[3]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(windowPoints), windowPoints, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    //Shader simples: basic.vert/basic.frag da biblioteca, na cor da casa
+    ShaderDefines houseColor = {{"SOLID_COLOR", "vec4(0.8, 0.6, 0.2, 1.0)"}};
+    std::string vertexShaderSource = preprocessShader("basic.vert", houseColor);
+    std::string fragmentShaderSource = preprocessShader("basic.frag", houseColor);
+
+    //Compilação de shaders numa thread com contexto compartilhado; enquanto não
+    //termina, os quadros saem com o programa reserva
+    AsyncShaderCompiler compiler = createAsyncShaderCompiler(window);
+    int shaderProgram = compileProgramAsync(compiler, vertexShaderSource.c_str(), fragmentShaderSource.c_str());
+
+    //Janela em amarelo claro: os mesmos shaders com outra cor, também na thread de trabalho
+    ShaderDefines windowColor = {{"SOLID_COLOR", "vec4(1.0, 0.9, 0.5, 1.0)"}};
+    int windowProgram = compileProgramAsync(compiler, preprocessShader("basic.vert", windowColor).c_str(),
+                                            preprocessShader("basic.frag", windowColor).c_str());
+
+    //==== Pool de geometria: casa e janela num único VAO/VBO/EBO ====
+    GeometryPool pool;
+    int house = addPoolIndexed(pool, houseMesh.positions.data(), houseMesh.vertexCount(),
+                               houseMesh.indices.data(), houseMesh.indices.size());
+    int windowShape = addPoolArrays(pool, windowPoints, 4);
+    uploadPool(pool);
+
+    PoolDrawList triangles;
+    triangles.mode = GL_TRIANGLES;
+    addToDrawList(triangles, pool, house);
+
+    PoolDrawList points;
+    points.mode = GL_POINTS;
+    addToDrawList(points, pool, windowShape);
 
     //Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (nextFrame(window)) {
         glClearColor(0.2f, 0.2f, 0.25f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
+        glstate::useProgram(asyncProgram(compiler, shaderProgram));
 
-        //Desenhar base
-        glBindVertexArray(VAOs[0]);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        bindPool(pool);
 
-        //Telhado
-        glBindVertexArray(VAOs[1]);
-        glDrawArrays(GL_TRIANGLES, 0, 3);
-
-        //Porta
-        glBindVertexArray(VAOs[2]);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        //Base, telhado e porta
+        drawPoolList(triangles);
 
         //Janela como pontos
-        glPointSize(10.0f);
-        glBindVertexArray(VAOs[3]);
-        glDrawArrays(GL_POINTS, 0, 4);
+        glstate::useProgram(asyncProgram(compiler, windowProgram));
+        glstate::pointSize(10.0f);
+        drawPoolList(points);
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        presentFrame(pacer, window);
     }
 
+    //Programa, VAO e tamanho de ponto repetidos a cada quadro que o cache evitou
+    glstate::Stats stateStats = glstate::stats();
+    std::cout << "Mudancas de estado redundantes evitadas: " << stateStats.skipped
+              << " de " << stateStats.issued + stateStats.skipped << std::endl;
+
     //Limpeza
-    glDeleteVertexArrays(4, VAOs);
-    glDeleteBuffers(4, VBOs);
-    glDeleteProgram(shaderProgram);
+    deletePool(pool);
+    deleteAsyncShaderCompiler(compiler);
+    clearShaderCache();
+    deleteFramePacer(pacer);
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
@@ -2,66 +2,11 @@
 #include <GLFW/glfw3.h>
 
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <string>
-
-// Função para carregar o código do shader de um arquivo
-std::string readShaderSource(const char* path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "Erro ao abrir o arquivo de shader: " << path << std::endl;
-        return "";
-    }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
-// Compila e cria um shader program
-GLuint createShaderProgram(const char* vertexPath, const char* fragmentPath) {
-    std::string vertexCode = readShaderSource(vertexPath);
-    std::string fragmentCode = readShaderSource(fragmentPath);
-
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
-
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vShaderCode, nullptr);
-    glCompileShader(vertexShader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-        std::cerr << "Erro de compilação do Vertex Shader:\n" << infoLog << std::endl;
-    }
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fShaderCode, nullptr);
-    glCompileShader(fragmentShader);
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-        std::cerr << "Erro de compilação do Fragment Shader:\n" << infoLog << std::endl;
-    }
-
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cerr << "Erro de linkagem do Shader Program:\n" << infoLog << std::endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
 
-    return shaderProgram;
-}
+#include <frame_pacing.h>
+#include <gl_state.h>
+#include <render_loop.h>
+#include <shader_manager.h>
 
 // Vertices para dois triângulos
 float vertices[] = {
@@ -74,7 +19,7 @@ float vertices[] = {
       0.5f,  0.5f, 0.0f
 };
 
-int main() {
+int main(int argc, char** argv) {
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -93,53 +38,76 @@ int main() {
         return -1;
     }
 
-    GLuint shaderProgram = createShaderProgram("../shaders/shader.vert", "../shaders/shader.frag");
+    // Ritmo de quadros: --vsync (padrão), --uncapped, --fps N, --max-frames N
+    FramePacer pacer = createFramePacer(argc, argv);
+
+    // Programas ligados vão para o disco: as próximas execuções não recompilam
+    enableProgramBinaryCache("shader_cache");
+
+    // --on-demand: só redesenha em redimensionamento, exposição ou entrada
+    setupRenderLoop(window, argc, argv);
+
+    // Shaders lidos de arquivo e recarregados ao salvar, sem reiniciar o programa
+    ShaderManager shaders = createShaderManager();
+    int program = loadShaderProgram(shaders, "../shaders/shader.vert", "../shaders/shader.frag");
 
     GLuint VAO, VBO;
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glstate::bindVertexArray(VAO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     // Atributo de posição
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0); 
-    glBindVertexArray(0); 
+    glstate::bindBuffer(GL_ARRAY_BUFFER, 0); 
+    glstate::bindVertexArray(0); 
 
     // Loop de renderização
-    while (!glfwWindowShouldClose(window)) {
+    while (nextFrame(window)) {
+        // Troca os programas editados desde o último quadro
+        updateShaderManager(shaders);
+
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
-        glBindVertexArray(VAO);
+        glstate::useProgram(shaderProgram(shaders, program));
+        glstate::bindVertexArray(VAO);
 
         // a) Triângulo preenchido
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glstate::polygonMode(GL_FILL);
         glDrawArrays(GL_TRIANGLES, 0, 3);
 
         // b) Apenas contorno
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        glstate::polygonMode(GL_LINE);
         glDrawArrays(GL_TRIANGLES, 3, 3);
 
         // c) Apenas pontos
-        glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+        glstate::polygonMode(GL_POINT);
         glDrawArrays(GL_TRIANGLES, 0, 3); // Reutiliza o primeiro triângulo
 
         // d) Todos juntos já foram demonstrados acima
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        presentFrame(pacer, window);
     }
 
+    // Programa e VAO repetidos a cada quadro que o cache evitou (os três polygon modes mudam de fato)
+    glstate::Stats stateStats = glstate::stats();
+    std::cout << "Mudancas de estado redundantes evitadas: " << stateStats.skipped
+              << " de " << stateStats.issued + stateStats.skipped << std::endl;
+
     // Limpeza
+    glstate::onDeleteVertexArray(VAO);
+    glstate::onDeleteBuffer(VBO);
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
-    glDeleteProgram(shaderProgram);
+    deleteShaderManager(shaders);
+    clearShaderCache();
+
+    deleteFramePacer(pacer);
 
     glfwDestroyWindow(window);
     glfwTerminate();
@@ -1,64 +1,209 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <cmath>
+#include <cstring>
 #include <vector>
 #include <iostream>
 
-#define PI 3.14159265359f
+#include <batch_renderer.h>
+#include <bulk_shapes.h>
+#include <frame_pacing.h>
+#include <geometry_pool.h>
+#include <gl_state.h>
+#include <instanced_shapes.h>
+#include <mesh.h>
+#include <procedural_shapes.h>
+#include <render_loop.h>
+#include <shader_cache.h>
+#include <shader_preprocessor.h>
+#include <shapes.h>
+#include <tessellation.h>
 
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
+//Círculo e arcos são tesselados conforme o tamanho em tela: regenerados ao redimensionar
+bool framebufferResized = false;
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
+    tessellation::setFramebufferSize(width, height);
+    framebufferResized = true;
 }
 
-std::vector<float> generatePolygonVertices(int sides, float radius, float centerX, float centerY) {
-    std::vector<float> vertices;
-    vertices.push_back(centerX); // Centro X
-    vertices.push_back(centerY); // Centro Y
-    vertices.push_back(0.0f);    // Z
-
-    for (int i = 0; i <= sides; i++) {
-        float angle = 2.0f * PI * i / sides;
-        float x = radius * cos(angle) + centerX;
-        float y = radius * sin(angle) + centerY;
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(0.0f);
-    }
-    return vertices;
+//Gerando vértices: cada forma é escrita em scratch e entregue a
+//visit(leque, número de vértices, closed). Polígonos e estrela fecham o contorno
+//(o último vértice repete o primeiro); arcos não. Como scratch mantém a
+//capacidade entre chamadas, regenerar ao redimensionar não aloca memória.
+template <typename Visit>
+void generateShapes(std::vector<float>& scratch, Visit visit) {
+    auto addFan = [&](std::size_t vertexCount, bool closed, auto write) {
+        scratch.resize(3 * vertexCount);
+        write(scratch.data());
+        visit(scratch.data(), vertexCount, closed);
+    };
+
+    //O círculo tem lados suficientes para um erro de 1/4 de pixel no tamanho atual da janela,
+    //calculados por rotação incremental com erro bem abaixo de um pixel
+    float circleRadius = 0.4f;
+    int circleSides = tessellation::segmentsForArc(circleRadius, 2.0f * PI);
+    addFan(polygonVertexCount(circleSides), true,
+           [&](float* out) { writePolygonVertices(out, circleSides, circleRadius, 0.0f, 0.0f, 1e-5f); });
+
+    //Formas com número fixo de lados vêm de tabelas calculadas na compilação
+    static constexpr auto unitOctagon  = generatePolygonVertices<8>();
+    static constexpr auto unitPentagon = generatePolygonVertices<5>();
+    static constexpr auto unitStar     = generateStar<5>();
+
+    addFan(unitOctagon.size() / 3, true,
+           [&](float* out) { writeUnitFan(out, unitOctagon, 0.3f, 0.3f, -0.6f, 0.5f); });
+    addFan(unitPentagon.size() / 3, true,
+           [&](float* out) { writeUnitFan(out, unitPentagon, 0.3f, 0.3f, 0.6f, -0.5f); });
+    addFan(arcVertexCount(PI / 4, 7 * PI / 4, 0.4f), false,
+           [&](float* out) { writeArc(out, PI / 4, 7 * PI / 4, 0.4f, -0.6f, -0.5f); });     //Pacman
+    addFan(arcVertexCount(0.0f, PI / 3, 0.4f), false,
+           [&](float* out) { writeArc(out, 0.0f, PI / 3, 0.4f, 0.0f, 0.6f); });             //Pizza
+    addFan(unitStar.size() / 3, true,
+           [&](float* out) { writeUnitFan(out, unitStar, 0.4f, 0.2f, 0.6f, 0.6f); });
 }
 
-std::vector<float> generateArc(float angleStart, float angleEnd, float radius, float centerX, float centerY) {
-    std::vector<float> vertices = { centerX, centerY, 0.0f };
-    int segments = 50;
-    for (int i = 0; i <= segments; i++) {
-        float angle = angleStart + (angleEnd - angleStart) * i / segments;
-        float x = radius * cos(angle) + centerX;
-        float y = radius * sin(angle) + centerY;
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(0.0f);
+//Modo de desenho, escolhido na linha de comando:
+//  (padrão)       malha indexada gerada na CPU, um glDrawElements
+//  --procedural   formas calculadas no vertex shader, sem VBO
+//  --instanced    uma malha unitária por classe de forma + atributos por instância
+//  --pool         leques de generateShapesBulk num VBO compartilhado, um glMultiDrawArrays
+//  --batch        renderizador em lote: formas regeneradas todo quadro, um draw por primitiva
+//  --restart      leques indexados separados por reinício de primitiva, um glDrawElements(GL_TRIANGLE_FAN)
+enum class RenderMode { Mesh, Procedural, Instanced, Pool, Batch, Restart };
+
+RenderMode parseRenderMode(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--procedural") == 0) return RenderMode::Procedural;
+        if (std::strcmp(argv[i], "--instanced") == 0) return RenderMode::Instanced;
+        if (std::strcmp(argv[i], "--pool") == 0) return RenderMode::Pool;
+        if (std::strcmp(argv[i], "--batch") == 0) return RenderMode::Batch;
+        if (std::strcmp(argv[i], "--restart") == 0) return RenderMode::Restart;
     }
-    return vertices;
+    return RenderMode::Mesh;
 }
 
-std::vector<float> generateStar(int points, float innerR, float outerR, float cx, float cy) {
-    std::vector<float> vertices = { cx, cy, 0.0f };
-    for (int i = 0; i <= points * 2; i++) {
-        float r = (i % 2 == 0) ? outerR : innerR;
-        float angle = i * PI / points;
-        float x = cx + r * cos(angle);
-        float y = cy + r * sin(angle);
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(0.0f);
-    }
-    return vertices;
+//Mesmas formas de buildShapesMesh, direto dos uniforms
+void drawProceduralShapes(const ProceduralShapeRenderer& renderer) {
+    beginProceduralShapes(renderer, 1.0f, 0.7f, 0.2f);
+    drawProceduralPolygon(renderer, tessellation::segmentsForArc(0.4f, 2.0f * PI), 0.4f, 0.0f, 0.0f);
+    drawProceduralPolygon(renderer, 8, 0.3f, -0.6f, 0.5f);
+    drawProceduralPolygon(renderer, 5, 0.3f, 0.6f, -0.5f);
+    drawProceduralArc(renderer, PI / 4, 7 * PI / 4, 0.4f, -0.6f, -0.5f);
+    drawProceduralArc(renderer, 0.0f, PI / 3, 0.4f, 0.0f, 0.6f);
+    drawProceduralStar(renderer, 5, 0.2f, 0.4f, 0.6f, 0.6f);
+}
+
+//Mesmas formas de buildShapesMesh, acrescentadas ao lote do quadro: todas
+//viram triângulos e saem num único glDrawArrays em endBatch
+void drawBatchedShapes(BatchRenderer& batch) {
+    beginBatch(batch);
+    setBatchColor(batch, 1.0f, 0.7f, 0.2f);
+    drawPolygon(batch, tessellation::segmentsForArc(0.4f, 2.0f * PI), 0.4f, 0.0f, 0.0f, 1e-5f);
+    drawPolygon(batch, 8, 0.3f, -0.6f, 0.5f);
+    drawPolygon(batch, 5, 0.3f, 0.6f, -0.5f);
+    drawArc(batch, PI / 4, 7 * PI / 4, 0.4f, -0.6f, -0.5f);
+    drawArc(batch, 0.0f, PI / 3, 0.4f, 0.0f, 0.6f);
+    drawStar(batch, 5, 0.2f, 0.4f, 0.6f, 0.6f);
+    endBatch(batch);
 }
 
-int main() {
+//Mesmas formas de buildShapesMesh como classes instanciadas: malha de raio 1 na
+//origem, posicionada por instância. Cada classe aqui tem uma instância, mas
+//acrescentar cópias não acrescenta chamadas de desenho.
+void buildInstancedShapes(std::vector<InstancedShapeClass>& classes) {
+    for (InstancedShapeClass& shape : classes)
+        deleteInstancedShapeClass(shape);
+    classes.clear();
+
+    auto addClass = [&](const std::vector<float>& unitFan, float radius, float cx, float cy) {
+        classes.push_back(createInstancedShapeClass(unitFan));
+        ShapeInstance instance = { cx, cy, radius, 0.0f, 1.0f, 0.7f, 0.2f, 1.0f };
+        setInstances(classes.back(), &instance, 1);
+    };
+
+    //Os lados do círculo e dos arcos dependem do raio em tela das instâncias
+    addClass(generatePolygonVertices(tessellation::segmentsForArc(0.4f, 2.0f * PI), 1.0f, 0.0f, 0.0f), 0.4f, 0.0f, 0.0f);
+    addClass(placeUnitFan(generatePolygonVertices<8>(), 1.0f, 0.0f, 0.0f), 0.3f, -0.6f, 0.5f);
+    addClass(placeUnitFan(generatePolygonVertices<5>(), 1.0f, 0.0f, 0.0f), 0.3f, 0.6f, -0.5f);
+    addClass(generateArc(PI / 4, 7 * PI / 4, 0.4f, 0.0f, 0.0f), 1.0f, -0.6f, -0.5f); //Raio já na malha (tesselação)
+    addClass(generateArc(0.0f, PI / 3, 0.4f, 0.0f, 0.0f), 1.0f, 0.0f, 0.6f);
+    addClass(placeUnitFan(generateStar<5>(), 1.0f, 0.5f, 0.0f, 0.0f), 0.4f, 0.6f, 0.6f);
+}
+
+//Todas as formas numa malha indexada, desenhada com um único glDrawElements
+//(o vértice repetido dos contornos fechados é descartado)
+void buildShapesMesh(IndexedMesh& mesh, std::vector<float>& scratch) {
+    mesh.clear();
+    generateShapes(scratch, [&](const float* fan, std::size_t vertexCount, bool closed) {
+        mesh.appendFan(fan, vertexCount, closed);
+    });
+}
+
+//Todas as formas como leques separados por reinício de primitiva, desenhados
+//com um único glDrawElements(GL_TRIANGLE_FAN, ...)
+void buildShapesRestartMesh(IndexedMesh& mesh, std::vector<float>& scratch) {
+    mesh.clear();
+    generateShapes(scratch, [&](const float* fan, std::size_t vertexCount, bool closed) {
+        mesh.appendRestartFan(fan, vertexCount, closed);
+    });
+}
+
+//Mesmas formas de generateShapes, como descrições para a geração em massa
+void describeShapes(std::vector<ShapeDesc>& shapes) {
+    shapes.clear();
+    auto polygon = [](int sides, float radius, float cx, float cy, float maxError) {
+        ShapeDesc shape;
+        shape.sides = sides;
+        shape.radius = radius;
+        shape.centerX = cx;
+        shape.centerY = cy;
+        shape.maxError = maxError;
+        return shape;
+    };
+    shapes.push_back(polygon(tessellation::segmentsForArc(0.4f, 2.0f * PI), 0.4f, 0.0f, 0.0f, 1e-5f));
+    shapes.push_back(polygon(8, 0.3f, -0.6f, 0.5f, 0.0f));
+    shapes.push_back(polygon(5, 0.3f, 0.6f, -0.5f, 0.0f));
+
+    ShapeDesc pacman = polygon(0, 0.4f, -0.6f, -0.5f, 0.0f);
+    pacman.kind = ShapeKind::Arc;
+    pacman.angleStart = PI / 4;
+    pacman.angleEnd = 7 * PI / 4;
+    shapes.push_back(pacman);
+
+    ShapeDesc pizza = polygon(0, 0.4f, 0.0f, 0.6f, 0.0f);
+    pizza.kind = ShapeKind::Arc;
+    pizza.angleStart = 0.0f;
+    pizza.angleEnd = PI / 3;
+    shapes.push_back(pizza);
+
+    ShapeDesc star = polygon(5, 0.4f, 0.6f, 0.6f, 0.0f);
+    star.kind = ShapeKind::Star;
+    star.innerRadius = 0.2f;
+    shapes.push_back(star);
+}
+
+//Todas as formas como leques no mesmo VBO, desenhados com um único glMultiDrawArrays.
+//Os vértices vêm de generateShapesBulk (em paralelo quando há formas
+//suficientes), e o first/count da geração vai direto para a lista de desenho.
+void buildShapesPool(GeometryPool& pool, PoolDrawList& fans, std::vector<ShapeDesc>& shapes, BulkShapes& bulk) {
+    describeShapes(shapes);
+    generateShapesBulk(shapes, bulk);
+
+    clearPool(pool);
+    clearDrawList(fans);
+    fans.mode = GL_TRIANGLE_FAN;
+    addPoolArraysToDrawList(fans, pool, bulk.vertices.data(), bulk.vertices.size() / 3,
+                            bulk.first.data(), bulk.count.data(), shapes.size());
+    uploadPool(pool);
+}
+
+int main(int argc, char** argv) {
+    RenderMode renderMode = parseRenderMode(argc, argv);
+
     //Inicialização GLFW + contexto
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -72,85 +217,109 @@ int main() {
     }
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    //--on-demand: só redesenha em redimensionamento, exposição ou entrada
+    setupRenderLoop(window, argc, argv);
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cout << "Falha ao carregar GLAD" << std::endl;
         return -1;
     }
 
-    //Gerando vértices
-    std::vector<float> circleVertices   = generatePolygonVertices(100, 0.4f,  0.0f,  0.0f);
-    std::vector<float> octagonVertices  = generatePolygonVertices(8,   0.3f, -0.6f,  0.5f);
-    std::vector<float> pentagonVertices = generatePolygonVertices(5,   0.3f,  0.6f, -0.5f);
-    std::vector<float> pacmanVertices   = generateArc(PI / 4, 7 * PI / 4, 0.4f, -0.6f, -0.5f);
-    std::vector<float> pizzaVertices    = generateArc(0.0f, PI / 3, 0.4f, 0.0f, 0.6f);
-    std::vector<float> starVertices     = generateStar(5, 0.2f, 0.4f, 0.6f, 0.6f);
-
-    std::vector<std::vector<float>> allShapes = {
-        circleVertices, octagonVertices, pentagonVertices,
-        pacmanVertices, pizzaVertices, starVertices
-    };
+    //Ritmo de quadros: --vsync (padrão), --uncapped, --fps N, --max-frames N
+    FramePacer pacer = createFramePacer(argc, argv);
+
+    //Programas ligados vão para o disco: as próximas execuções não recompilam
+    enableProgramBinaryCache("shader_cache");
 
-    unsigned int VAOs[6], VBOs[6];
-    glGenVertexArrays(6, VAOs);
-    glGenBuffers(6, VBOs);
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    tessellation::setFramebufferSize(fbWidth, fbHeight);
 
-    for (int i = 0; i < 6; i++) {
-        glBindVertexArray(VAOs[i]);
-        glBindBuffer(GL_ARRAY_BUFFER, VBOs[i]);
-        glBufferData(GL_ARRAY_BUFFER, allShapes[i].size() * sizeof(float), allShapes[i].data(), GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
+    IndexedMesh shapes;
+    std::vector<float> scratch;
+    GpuMesh shapesMesh;
+    ProceduralShapeRenderer procedural;
+    std::vector<InstancedShapeClass> instancedShapes;
+    GLuint instancedProgram = 0;
+    GeometryPool pool;
+    PoolDrawList poolFans;
+    std::vector<ShapeDesc> poolShapes;
+    BulkShapes bulkShapes;
+    BatchRenderer batch;
+    if (renderMode == RenderMode::Procedural) {
+        procedural = createProceduralShapeRenderer();
+    } else if (renderMode == RenderMode::Instanced) {
+        instancedProgram = createInstancedShapeProgram();
+        buildInstancedShapes(instancedShapes);
+    } else if (renderMode == RenderMode::Pool) {
+        buildShapesPool(pool, poolFans, poolShapes, bulkShapes);
+    } else if (renderMode == RenderMode::Batch) {
+        batch = createBatchRenderer();
+    } else if (renderMode == RenderMode::Restart) {
+        buildShapesRestartMesh(shapes, scratch);
+        uploadMesh(shapesMesh, shapes);
+    } else {
+        buildShapesMesh(shapes, scratch);
+        uploadMesh(shapesMesh, shapes);
     }
 
-    //Shaders
-    const char* vertexShaderSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPos;
-        void main() {
-            gl_Position = vec4(aPos, 1.0);
-        }
-    )";
-    const char* fragmentShaderSource = R"(
-        #version 330 core
-        out vec4 FragColor;
-        void main() {
-            FragColor = vec4(1.0, 0.7, 0.2, 1.0); // Laranja claro
-        }
-    )";
-
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    //Shaders: basic.vert/basic.frag da biblioteca, na variante laranja claro.
+    //Só é compilada no primeiro quadro que desenhar com ela (malha, pool ou restart)
+    ShaderPermutations basicShaders = createShaderPermutations("basic.vert", "basic.frag");
+    int lightOrange = shaderVariant(basicShaders, {{"SOLID_COLOR", "vec4(1.0, 0.7, 0.2, 1.0)"}});
 
     //Loop de renderização
-    while (!glfwWindowShouldClose(window)) {
+    while (nextFrame(window)) {
+        if (framebufferResized) {
+            if (renderMode == RenderMode::Mesh) {
+                buildShapesMesh(shapes, scratch);
+                uploadMesh(shapesMesh, shapes);
+            } else if (renderMode == RenderMode::Instanced) {
+                buildInstancedShapes(instancedShapes);
+            } else if (renderMode == RenderMode::Pool) {
+                buildShapesPool(pool, poolFans, poolShapes, bulkShapes);
+            } else if (renderMode == RenderMode::Restart) {
+                buildShapesRestartMesh(shapes, scratch);
+                uploadMesh(shapesMesh, shapes);
+            }
+            framebufferResized = false;
+        }
+
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
-        for (int i = 0; i < 6; i++) {
-            glBindVertexArray(VAOs[i]);
-            glDrawArrays(GL_TRIANGLE_FAN, 0, allShapes[i].size() / 3);
+        if (renderMode == RenderMode::Procedural) {
+            drawProceduralShapes(procedural);
+        } else if (renderMode == RenderMode::Instanced) {
+            glstate::useProgram(instancedProgram);
+            for (const InstancedShapeClass& shape : instancedShapes)
+                drawInstanced(shape);
+        } else if (renderMode == RenderMode::Pool) {
+            glstate::useProgram(variantProgram(basicShaders, lightOrange));
+            bindPool(pool);
+            drawPoolList(poolFans);
+        } else if (renderMode == RenderMode::Batch) {
+            drawBatchedShapes(batch);
+        } else if (renderMode == RenderMode::Restart) {
+            glstate::useProgram(variantProgram(basicShaders, lightOrange));
+            drawMesh(shapesMesh, GL_TRIANGLE_FAN);
+        } else {
+            glstate::useProgram(variantProgram(basicShaders, lightOrange));
+            drawMesh(shapesMesh);
         }
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        presentFrame(pacer, window);
     }
 
     //Cleanup
-    glDeleteVertexArrays(6, VAOs);
-    glDeleteBuffers(6, VBOs);
-    glDeleteProgram(shaderProgram);
+    deleteMesh(shapesMesh);
+    deleteProceduralShapeRenderer(procedural);
+    for (InstancedShapeClass& shape : instancedShapes)
+        deleteInstancedShapeClass(shape);
+    deletePool(pool);
+    deleteBatchRenderer(batch);
+    clearShaderCache();
+    deleteFramePacer(pacer);
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
@@ -1,38 +1,47 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <cmath>
+#include <cstring>
 #include <vector>
 #include <iostream>
 
-#define PI 3.14159265359f
+#include <frame_pacing.h>
+#include <gl_state.h>
+#include <polyline.h>
+#include <procedural_shapes.h>
+#include <render_loop.h>
+#include <shader_cache.h>
+#include <shader_preprocessor.h>
+#include <shapes.h>
+#include <stream_buffer.h>
+#include <tessellation.h>
 
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
+//A amostragem da espiral depende do tamanho em tela: regenerada ao redimensionar
+bool framebufferResized = false;
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
+    tessellation::setFramebufferSize(width, height);
+    framebufferResized = true;
 }
 
-//Geração da espiral
-std::vector<float> generateSpiral(int numTurns, int segmentsPerTurn, float maxRadius, float centerX, float centerY) {
-    std::vector<float> vertices;
-    float totalSegments = numTurns * segmentsPerTurn;
-
-    for (int i = 0; i <= totalSegments; i++) {
-        float t = (float)i / totalSegments;
-        float angle = 2.0f * PI * numTurns * t;
-        float radius = maxRadius * t;
-        float x = radius * cos(angle) + centerX;
-        float y = radius * sin(angle) + centerY;
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(0.0f);
+int main(int argc, char** argv) {
+    //--procedural: espiral calculada no vertex shader a partir de gl_VertexID, sem VBO
+    //--stream: espiral pulsante, regenerada todo quadro num buffer em anel
+    //--thick: linha de 6 pixels com anti-aliasing, expandida no vertex shader
+    bool procedural = false;
+    bool stream = false;
+    bool thick = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--procedural") == 0) procedural = true;
+        if (std::strcmp(argv[i], "--stream") == 0) stream = true;
+        if (std::strcmp(argv[i], "--thick") == 0) thick = true;
     }
+    const float thickWidthPx = 6.0f;
 
-    return vertices;
-}
-
-int main() {
     //Inicializa GLFW e configura contexto OpenGL
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -47,6 +56,9 @@ int main() {
     }
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    //--on-demand: só redesenha em redimensionamento, exposição, entrada ou, com
+    //--stream, no timer da animação
+    setupRenderLoop(window, argc, argv);
 
     //Carrega funções do OpenGL com GLAD
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -54,67 +66,136 @@ int main() {
         return -1;
     }
 
-    //Gera vértices da espiral
-    std::vector<float> spiralVertices = generateSpiral(5, 100, 0.6f, 0.0f, 0.0f);
-
-    //Configura VAO e VBO
-    unsigned int spiralVAO, spiralVBO;
-    glGenVertexArrays(1, &spiralVAO);
-    glGenBuffers(1, &spiralVBO);
-
-    glBindVertexArray(spiralVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, spiralVBO);
-    glBufferData(GL_ARRAY_BUFFER, spiralVertices.size() * sizeof(float), spiralVertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    //Shaders simples
-    const char* vertexShaderSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPos;
-        void main() {
-            gl_Position = vec4(aPos, 1.0);
-        }
-    )";
-    const char* fragmentShaderSource = R"(
-        #version 330 core
-        out vec4 FragColor;
-        void main() {
-            FragColor = vec4(0.9, 0.6, 0.1, 1.0); // Laranja
+    //Ritmo de quadros: --vsync (padrão), --uncapped, --fps N, --max-frames N
+    FramePacer pacer = createFramePacer(argc, argv);
+
+    //Programas ligados vão para o disco: as próximas execuções não recompilam
+    enableProgramBinaryCache("shader_cache");
+
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    tessellation::setFramebufferSize(fbWidth, fbHeight);
+
+    //Gera vértices da espiral com passo limitado pela curvatura: flecha de cada
+    //segmento <= 1/4 de pixel, com menos vértices nas voltas internas
+    const int numTurns = 5;
+    const float maxRadius = 0.6f;
+    std::vector<float> spiralVertices;
+    unsigned int spiralVAO = 0, spiralVBO = 0;
+    ProceduralShapeRenderer proceduralRenderer;
+    StreamBuffer streamBuffer;
+
+    if (procedural) {
+        proceduralRenderer = createProceduralShapeRenderer();
+    } else if (stream) {
+        //O atributo aponta para o início do buffer; cada quadro desenha a partir
+        //do firstVertex da sua região
+        std::size_t maxVertices = spiralAdaptiveVertexCount(SpiralSampling::Curvature, numTurns, maxRadius,
+                                                            tessellation::pixelErrorToNdc());
+        streamBuffer = createStreamBuffer(maxVertices * 3 * sizeof(float));
+
+        glGenVertexArrays(1, &spiralVAO);
+        glstate::bindVertexArray(spiralVAO);
+        glstate::bindBuffer(GL_ARRAY_BUFFER, streamBuffer.VBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+    } else {
+        spiralVertices = generateSpiralAdaptive(SpiralSampling::Curvature, numTurns, maxRadius,
+                                                tessellation::pixelErrorToNdc(), 0.0f, 0.0f);
+
+        //Configura VAO e VBO
+        glGenVertexArrays(1, &spiralVAO);
+        glGenBuffers(1, &spiralVBO);
+
+        glstate::bindVertexArray(spiralVAO);
+        glstate::bindBuffer(GL_ARRAY_BUFFER, spiralVBO);
+        glBufferData(GL_ARRAY_BUFFER, spiralVertices.size() * sizeof(float), spiralVertices.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+    }
+
+    //Shaders simples: basic.vert/basic.frag da biblioteca, em laranja (amarelo
+    //na animação do --stream). As variantes só são compiladas quando um quadro
+    //desenha com elas: cada execução compila apenas a do seu modo
+    ShaderPermutations basicShaders = createShaderPermutations("basic.vert", "basic.frag");
+    int orange = shaderVariant(basicShaders, {{"SOLID_COLOR", "vec4(0.9, 0.6, 0.1, 1.0)"}});
+    int yellow = shaderVariant(basicShaders, {{"SOLID_COLOR", "vec4(1.0, 0.85, 0.2, 1.0)"}});
+
+    //A linha grossa lê os segmentos do mesmo VBO da espiral
+    PolylineRenderer polylineRenderer;
+    Polyline spiralPolyline;
+    if (thick && !procedural) {
+        polylineRenderer = createPolylineRenderer();
+        spiralPolyline = createPolyline(stream ? streamBuffer.VBO : spiralVBO,
+                                        static_cast<GLsizei>(spiralVertices.size() / 3));
+    }
+    auto drawSpiralStrip = [&](GLint first, GLsizei count) {
+        if (thick) {
+            setPolylineRange(spiralPolyline, first, count);
+            drawPolyline(polylineRenderer, spiralPolyline, thickWidthPx, 0.9f, 0.6f, 0.1f);
+        } else {
+            glstate::useProgram(variantProgram(basicShaders, stream ? yellow : orange));
+            glstate::bindVertexArray(spiralVAO);
+            glDrawArrays(GL_LINE_STRIP, first, count);
         }
-    )";
-
-    //Compila shaders
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    };
 
     //Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (nextFrame(window)) {
+        if (framebufferResized && !procedural && !stream) {
+            //Reaproveita a memória do vetor: só aloca se a espiral crescer
+            float maxError = tessellation::pixelErrorToNdc();
+            spiralVertices.resize(3 * spiralAdaptiveVertexCount(SpiralSampling::Curvature, numTurns, maxRadius, maxError));
+            writeSpiralAdaptive(spiralVertices.data(), SpiralSampling::Curvature, numTurns, maxRadius, maxError, 0.0f, 0.0f);
+            glstate::bindBuffer(GL_ARRAY_BUFFER, spiralVBO);
+            glBufferData(GL_ARRAY_BUFFER, spiralVertices.size() * sizeof(float), spiralVertices.data(), GL_STATIC_DRAW);
+            framebufferResized = false;
+        }
+
         glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
-        glBindVertexArray(spiralVAO);
-        glDrawArrays(GL_LINE_STRIP, 0, spiralVertices.size() / 3);
+        if (procedural) {
+            //Amostragem uniforme: o índice do vértice vira t direto no shader
+            beginProceduralShapes(proceduralRenderer, 0.9f, 0.6f, 0.1f);
+            drawProceduralSpiral(proceduralRenderer, numTurns, tessellation::segmentsForArc(maxRadius, 2.0f * PI), maxRadius, 0.0f, 0.0f);
+        } else if (stream) {
+            //Raio oscilando entre 70% e 100%: o número de vértices muda a cada quadro
+            float radius = maxRadius * (0.85f + 0.15f * std::sin(2.0f * static_cast<float>(glfwGetTime())));
+            float maxError = tessellation::pixelErrorToNdc();
+            std::size_t vertexCount = spiralAdaptiveVertexCount(SpiralSampling::Curvature, numTurns, radius, maxError);
+            reserveStreamBuffer(streamBuffer, vertexCount * 3 * sizeof(float)); //só realoca se a janela crescer
+
+            beginStreamFrame(streamBuffer);
+            StreamSpan span = streamAllocate(streamBuffer, vertexCount, 3 * sizeof(float));
+            if (span.data) {
+                writeSpiralAdaptive(static_cast<float*>(span.data), SpiralSampling::Curvature, numTurns, radius, maxError, 0.0f, 0.0f);
+                if (streamCommit(streamBuffer, span))
+                    drawSpiralStrip(span.firstVertex, static_cast<GLsizei>(vertexCount));
+            }
+            endStreamFrame(streamBuffer);
+            scheduleRedraw(0.0); //animação: o próximo quadro já está pendente
+        } else {
+            drawSpiralStrip(0, static_cast<GLsizei>(spiralVertices.size() / 3));
+        }
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        presentFrame(pacer, window);
     }
 
+    std::cout << "Variantes de shader compiladas: " << compiledVariantCount(basicShaders)
+              << " de " << basicShaders.variants.size() << std::endl;
+
     //Libera recursos
+    glstate::onDeleteVertexArray(spiralVAO);
+    glstate::onDeleteBuffer(spiralVBO);
     glDeleteVertexArrays(1, &spiralVAO);
     glDeleteBuffers(1, &spiralVBO);
-    glDeleteProgram(shaderProgram);
+    deletePolyline(spiralPolyline);
+    deletePolylineRenderer(polylineRenderer);
+    deleteStreamBuffer(streamBuffer);
+    deleteProceduralShapeRenderer(proceduralRenderer);
+    clearShaderCache();
+    deleteFramePacer(pacer);
     glfwTerminate();
 
     return 0;
@@ -1,7 +1,15 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <cstring>
 #include <iostream>
 
+#include <frame_pacing.h>
+#include <gl_state.h>
+#include <render_loop.h>
+#include <shader_cache.h>
+#include <shader_preprocessor.h>
+#include <vertex_formats.h>
+
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
@@ -9,7 +17,16 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
-int main() {
+int main(int argc, char** argv) {
+    //Posições em int16 normalizado; --half usa half floats
+    //Vértices intercalados; --split guarda posições e cores em fluxos separados
+    PositionFormat positionFormat = PositionFormat::Snorm16;
+    VertexStorage storage = VertexStorage::Interleaved;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--half") == 0) positionFormat = PositionFormat::Half;
+        if (std::strcmp(argv[i], "--split") == 0) storage = VertexStorage::Split;
+    }
+
     //Inicialização do GLFW
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -24,6 +41,8 @@ int main() {
     }
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    //--on-demand: só redesenha em redimensionamento, exposição ou entrada
+    setupRenderLoop(window, argc, argv);
 
     //Inicializa GLAD
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -31,12 +50,19 @@ int main() {
         return -1;
     }
 
-    //Dados do triângulo (x, y, z, r, g, b)
-    float triangleVertices[] = {
-        //posições         //cores
-        -0.5f, -0.5f, 0.0f,  1.0f, 0.0f, 0.0f, //Vértice 1: Vermelho
-         0.5f, -0.5f, 0.0f,  0.0f, 1.0f, 0.0f, //Vértice 2: Verde
-         0.0f,  0.5f, 0.0f,  0.0f, 0.0f, 1.0f  //Vértice 3: Azul
+    //Ritmo de quadros: --vsync (padrão), --uncapped, --fps N, --max-frames N
+    FramePacer pacer = createFramePacer(argc, argv);
+
+    //Programas ligados vão para o disco: as próximas execuções não recompilam
+    enableProgramBinaryCache("shader_cache");
+
+    //Dados do triângulo (x, y, r, g, b, a), compactados em 8 bytes por vértice:
+    //z = 0 fica implícito e a cor vira RGBA8
+    PackedVertex2D triangleVertices[] = {
+        //posições          //cores
+        packVertex2D(-0.5f, -0.5f,  1.0f, 0.0f, 0.0f, 1.0f, positionFormat), //Vértice 1: Vermelho
+        packVertex2D( 0.5f, -0.5f,  0.0f, 1.0f, 0.0f, 1.0f, positionFormat), //Vértice 2: Verde
+        packVertex2D( 0.0f,  0.5f,  0.0f, 0.0f, 1.0f, 1.0f, positionFormat)  //Vértice 3: Azul
     };
 
     //Criação do VAO e VBO
@@ -44,74 +70,33 @@ int main() {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(triangleVertices), triangleVertices, GL_STATIC_DRAW);
-
-    //Atributo de posição (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    //Atributo de cor (location = 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    //Shaders
-    const char* vertexShaderSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aColor;
-        out vec3 vertexColor;
-        void main() {
-            gl_Position = vec4(aPos, 1.0);
-            vertexColor = aColor;
-        }
-    )";
-
-    const char* fragmentShaderSource = R"(
-        #version 330 core
-        in vec3 vertexColor;
-        out vec4 FragColor;
-        void main() {
-            FragColor = vec4(vertexColor, 1.0);
-        }
-    )";
-
-    //Compilação e link dos shaders
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    //Envia os vértices e configura posição (location = 0, 2 x 16 bits) e cor
+    //(location = 1, RGBA8 normalizado) a partir do layout de PackedVertex2D
+    uploadVertices(VAO, VBO, packedVertex2DLayout(positionFormat), triangleVertices, 3, storage);
+
+    //Shaders: basic.vert/basic.frag da biblioteca, com cor por vértice
+    ShaderPermutations basicShaders = createShaderPermutations("basic.vert", "basic.frag");
+    int vertexColor = shaderVariant(basicShaders, {{"VERTEX_COLOR", ""}});
 
     //Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (nextFrame(window)) {
         glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
-        glBindVertexArray(VAO);
+        glstate::useProgram(variantProgram(basicShaders, vertexColor));
+        glstate::bindVertexArray(VAO);
         glDrawArrays(GL_TRIANGLES, 0, 3);
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        presentFrame(pacer, window);
     }
 
     //Limpeza
+    glstate::onDeleteVertexArray(VAO);
+    glstate::onDeleteBuffer(VBO);
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
-    glDeleteProgram(shaderProgram);
+    clearShaderCache();
+    deleteFramePacer(pacer);
     glfwTerminate();
 
     return 0;